@@ -18,10 +18,12 @@
 */
 
 #include <iostream>
+#include <string>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParserStatistics.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -31,10 +33,14 @@
 inline void dumpMessages( const Opm::MessageContainer& messageContainer) {
     auto extractMessage = [](const Opm::Message& msg) {
         const auto& location = msg.location;
+        std::string text = msg.message;
         if (location)
-            return location.filename + ":" + std::to_string( location.lineno ) + " " + msg.message;
-        else
-            return msg.message;
+            text = location.filename + ":" + std::to_string( location.lineno ) + " " + text;
+
+        if (msg.count > 1)
+            text += " (repeated " + std::to_string( msg.count ) + " times)";
+
+        return text;
     };
 
 
@@ -43,9 +49,12 @@ inline void dumpMessages( const Opm::MessageContainer& messageContainer) {
 }
 
 
-inline void loadDeck( const char * deck_file) {
+enum class stats_format { none, table, json };
+
+inline void loadDeck( const char * deck_file, stats_format stats) {
     Opm::ParseContext parseContext;
     Opm::Parser parser;
+    parser.enableStatistics( stats != stats_format::none );
 
     std::cout << "Loading deck: " << deck_file << " ..... "; std::cout.flush();
     auto deck = parser.parseFile(deck_file, parseContext);
@@ -56,11 +65,35 @@ inline void loadDeck( const char * deck_file) {
     std::cout << "complete." << std::endl;
 
     dumpMessages( deck.getMessageContainer() );
+
+    if (stats == stats_format::table)
+        deck.getParserStatistics()->writeTable( std::cout );
+    else if (stats == stats_format::json)
+        deck.getParserStatistics()->writeJSON( std::cout );
 }
 
 
+/*
+  Usage: opmi [--stats[=table|json]] DECK1 [DECK2 ...]
+
+  With --stats the parser statistics - time spent in the different parser
+  phases, per keyword and per include file - is printed after each deck.
+*/
 int main(int argc, char** argv) {
-    for (int iarg = 1; iarg < argc; iarg++)
-        loadDeck( argv[iarg] );
+    stats_format stats = stats_format::none;
+
+    for (int iarg = 1; iarg < argc; iarg++) {
+        const std::string arg = argv[iarg];
+
+        if (arg == "--stats" || arg == "--stats=table")
+            stats = stats_format::table;
+        else if (arg == "--stats=json")
+            stats = stats_format::json;
+        else if (arg.compare( 0, 2, "--" ) == 0) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        } else
+            loadDeck( argv[iarg], stats );
+    }
 }
 
@@ -170,7 +170,8 @@ namespace Opm {
         m_messageContainer( d.m_messageContainer ),
         defaultUnits( d.defaultUnits ),
         activeUnits( d.activeUnits ),
-        m_dataFile( d.m_dataFile ) {
+        m_dataFile( d.m_dataFile ),
+        m_statistics( d.m_statistics ) {
 
         this->reinit(this->keywordList.begin(), this->keywordList.end());
     }
@@ -222,6 +223,14 @@ namespace Opm {
         m_dataFile = dataFile;
     }
 
+    std::shared_ptr< const ParserStatistics > Deck::getParserStatistics() const {
+        return this->m_statistics;
+    }
+
+    void Deck::setParserStatistics( std::shared_ptr< const ParserStatistics > statistics ) {
+        this->m_statistics = std::move( statistics );
+    }
+
     Deck::iterator Deck::begin() {
         return this->keywordList.begin();
     }
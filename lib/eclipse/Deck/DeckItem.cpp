@@ -23,6 +23,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <cmath>
@@ -226,11 +227,16 @@ const std::vector< double >& DeckItem::getSIDoubleData() const {
     const auto sz = raw.size();
     this->SIdata.resize( sz );
 
-    for( size_t index = 0; index < sz; index++ ) {
-        const auto dimIndex = index % dim_size;
-        this->SIdata[ index ] = this->dimensions[ dimIndex ]
-                                .convertRawToSi( raw[ index ] );
-    }
+    /*
+     * The dimensions are applied cyclically; element i uses dimension
+     * i % dim_size. That is one strided pass per dimension, starting at
+     * offset dim_index.
+     */
+    for( size_t dim_index = 0; dim_index < std::min( dim_size, sz ); dim_index++ )
+        this->dimensions[ dim_index ].convertRawToSi( raw.data() + dim_index,
+                                                      this->SIdata.data() + dim_index,
+                                                      sz - dim_index,
+                                                      dim_size );
 
     return this->SIdata;
 }
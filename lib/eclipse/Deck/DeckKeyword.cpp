@@ -29,7 +29,8 @@ namespace Opm {
         m_lineNumber(-1),
         m_knownKeyword(true),
         m_isDataKeyword(false),
-        m_slashTerminated(true)
+        m_slashTerminated(true),
+        m_parserKeyword(nullptr)
     {
     }
 
@@ -38,7 +39,8 @@ namespace Opm {
         m_lineNumber(-1),
         m_knownKeyword(knownKeyword),
         m_isDataKeyword(false),
-        m_slashTerminated(true)
+        m_slashTerminated(true),
+        m_parserKeyword(nullptr)
     {
     }
 
@@ -68,6 +70,14 @@ namespace Opm {
         return m_isDataKeyword;
     }
 
+    void DeckKeyword::setParserKeyword(const ParserKeyword* parserKeyword) {
+        m_parserKeyword = parserKeyword;
+    }
+
+    const ParserKeyword* DeckKeyword::getParserKeyword() const {
+        return m_parserKeyword;
+    }
+
 
     const std::string& DeckKeyword::name() const {
         return m_keywordName;
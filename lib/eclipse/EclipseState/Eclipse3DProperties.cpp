@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <memory>
 #include <set>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -27,10 +29,13 @@
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/BoxManager.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
 namespace Opm {
@@ -49,18 +54,44 @@ namespace Opm {
             }
         }
 
-        // this funcion applies a single pore volume multiplier (i.e., it deals with a single
-        // record of the MULTREGP keyword)
-        void applyPorosityRegionMultiplier_(std::vector<double>& porev,
-                                            const std::vector<int>& regionId,
-                                            int multRegionId,
-                                            double multValue)
-        {
-            for (unsigned i = 0; i < porev.size(); ++i) {
-                if (regionId[i] == multRegionId)
-                    porev[i] *= multValue;
+        /*
+          The MULTREGP multipliers for one region property, as a list of
+          (region, record, multiplier) entries sorted by region value;
+          record is the index of the MULTREGP record, which gives the
+          order the multipliers are applied in when a cell is in regions
+          of several properties. The list holds one entry per MULTREGP
+          record, so arbitrarily large region values are cheap.
+        */
+        struct RegionMultipliers {
+            struct Entry {
+                int region;
+                int record;
+                double multiplier;
+
+                bool operator<( int other ) const {
+                    return region < other;
+                }
+            };
+
+            const std::vector< int >* regionId = nullptr;
+            std::vector< Entry > entries;
+
+            void add( int region, double value, int recordIdx ) {
+                auto pos = std::lower_bound( entries.begin(), entries.end(), region );
+                if (pos != entries.end() && pos->region == region)
+                    *pos = { region, recordIdx, value };
+                else
+                    entries.insert( pos, { region, recordIdx, value } );
             }
-        }
+
+            const Entry* find( int region ) const {
+                auto pos = std::lower_bound( entries.begin(), entries.end(), region );
+                if (pos == entries.end() || pos->region != region)
+                    return nullptr;
+
+                return &*pos;
+            }
+        };
 
         /// this function initializes the pore volume of all cells. it uses the raw keyword
         /// 'MULTREGP', the integer grid properties 'FLUXNUM', 'MULTNUM' and 'OPERNUM' as
@@ -75,26 +106,16 @@ namespace Opm {
             const auto& ntg =  doubleGridProperties->getKeyword("NTG");
 
             const auto& poroData = poro.getData();
-            for (size_t globalIndex = 0; globalIndex < poro.getCartesianSize(); globalIndex++) {
-                if (!std::isfinite(values[globalIndex])) {
-                    double cell_poro = poroData[globalIndex];
-                    if (std::isnan(cell_poro))
-                        throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
-
-                    double cell_ntg = ntg.iget(globalIndex);
-                    double cell_volume = eclipseGrid->getCellVolume(globalIndex);
-                    values[globalIndex] = cell_poro * cell_volume * cell_ntg;
-                }
-            }
+            const auto& volume = eclipseGrid->getGeometry().getVolume();
 
-            if (doubleGridProperties->hasKeyword("MULTPV")) {
-                const GridProperty<double>& multpvKeyword = doubleGridProperties->getKeyword("MULTPV");
-                const auto& multpvData = multpvKeyword.getData();
-                for (size_t globalIndex = 0; globalIndex < multpvData.size(); globalIndex++)
-                    values[globalIndex] *= multpvData[globalIndex];
-            }
+            const std::vector< double >* multpvData = nullptr;
+            if (doubleGridProperties->hasKeyword("MULTPV"))
+                multpvData = &doubleGridProperties->getKeyword("MULTPV").getData();
 
-            // deal with the region multiplier for porosity
+            // the region multipliers for porosity; the region types are
+            // M(ULTNUM), F(LUXNUM) and O(PERNUM).
+            std::string illegalRegionType;
+            RegionMultipliers regionMultipliers[3];
             if (deck->hasKeyword("MULTREGP")) {
                 const DeckKeyword& multregpKeyword = deck->getKeyword("MULTREGP");
                 for (unsigned recordIdx = 0; recordIdx < multregpKeyword.size(); ++recordIdx) {
@@ -125,22 +146,63 @@ namespace Opm {
                         // the region was specified twice
                         continue;
 
-                    if (regionType == "M") {
-                        const GridProperty<int>& multnumProp = intGridProperties->getKeyword("MULTNUM");
-                        applyPorosityRegionMultiplier_(values, multnumProp.getData(), regionId, multValue);
-                    }
-                    else if (regionType == "F") {
-                        const GridProperty<int>& fluxnumProp = intGridProperties->getKeyword("FLUXNUM");
-                        applyPorosityRegionMultiplier_(values, fluxnumProp.getData(), regionId, multValue);
+                    const std::string regionTypes[3] = { "M", "F", "O" };
+                    const std::string regionArrays[3] = { "MULTNUM", "FLUXNUM", "OPERNUM" };
+                    const auto type = std::find( regionTypes, regionTypes + 3, regionType ) - regionTypes;
+                    if (type == 3) {
+                        // reported after the porosity check, in record order.
+                        illegalRegionType = regionType;
+                        break;
                     }
-                    else if (regionType == "O") {
-                        const GridProperty<int>& opernumProp = intGridProperties->getKeyword("OPERNUM");
-                        applyPorosityRegionMultiplier_(values, opernumProp.getData(), regionId, multValue);
-                    }
-                    else
-                        throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+regionType+"'");
+
+                    auto& multipliers = regionMultipliers[type];
+                    if (!multipliers.regionId)
+                        multipliers.regionId = &intGridProperties->getKeyword( regionArrays[type] ).getData();
+
+                    multipliers.add( regionId, multValue, recordIdx );
                 }
             }
+
+            /*
+              One pass over the cells: the pore volume from PORO, NTG
+              and the cell volume if it is not given explicitly, then
+              the MULTPV and MULTREGP multipliers - in the same order as
+              applying them one keyword and record at a time.
+            */
+            parallel::for_ranges( poro.getCartesianSize(), [&]( size_t begin, size_t end ) {
+                    for (size_t globalIndex = begin; globalIndex < end; globalIndex++) {
+                        if (!std::isfinite(values[globalIndex])) {
+                            double cell_poro = poroData[globalIndex];
+                            if (std::isnan(cell_poro))
+                                throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
+
+                            double cell_ntg = ntg.iget(globalIndex);
+                            double cell_volume = volume[globalIndex];
+                            values[globalIndex] = cell_poro * cell_volume * cell_ntg;
+                        }
+
+                        if (multpvData)
+                            values[globalIndex] *= (*multpvData)[globalIndex];
+
+                        std::pair< int, double > cellMultipliers[3];
+                        size_t numMultipliers = 0;
+                        for (const auto& multipliers : regionMultipliers) {
+                            if (!multipliers.regionId)
+                                continue;
+
+                            const auto* entry = multipliers.find( (*multipliers.regionId)[globalIndex] );
+                            if (entry)
+                                cellMultipliers[numMultipliers++] = { entry->record, entry->multiplier };
+                        }
+
+                        std::sort( cellMultipliers, cellMultipliers + numMultipliers );
+                        for (size_t m = 0; m < numMultipliers; m++)
+                            values[globalIndex] *= cellMultipliers[m].second;
+                    }
+                } );
+
+            if (!illegalRegionType.empty())
+                throw std::logic_error("Unknown or illegal region type for MULTREGP keyword: '"+illegalRegionType+"'");
         }
 
 
@@ -505,6 +567,19 @@ namespace Opm {
                                                 "1");
         }
 
+        /*
+          With GDFILE the grid is loaded from a binary grid file, and the
+          active cells of the grid file are the initial value of ACTNUM.
+        */
+        if (deck.hasKeyword( "GDFILE" ) && eclipseGrid.getNumActive() < eclipseGrid.getCartesianSize()) {
+            std::vector< int > actnum;
+            eclipseGrid.exportACTNUM( actnum );
+
+            auto& property = m_intGridProperties.getOrCreateProperty( "ACTNUM" );
+            for (size_t g = 0; g < actnum.size(); g++)
+                property.iset( g, actnum[g] );
+        }
+
         processGridProperties(deck, eclipseGrid);
     }
 
@@ -560,21 +635,36 @@ namespace Opm {
     const GridProperty<int>& Eclipse3DProperties::getRegion( const DeckItem& regionItem ) const {
         if (regionItem.defaultApplied(0))
             return m_intGridProperties.getKeyword( m_defaultRegion );
-        else {
-            const std::string regionArray = MULTREGT::RegionNameFromDeckValue( regionItem.get< std::string >(0) );
-            return m_intGridProperties.getDeckKeyword( regionArray );
-        }
+        else
+            return m_intGridProperties.getDeckKeyword( getRegionName( regionItem ) );
+    }
+
+    std::string Eclipse3DProperties::getRegionName( const DeckItem& regionItem ) const {
+        if (regionItem.defaultApplied(0))
+            return m_defaultRegion;
+        else
+            return MULTREGT::RegionNameFromDeckValue( regionItem.get< std::string >(0) );
+    }
+
+    /*
+      True if getRegion() will return an existing property, without
+      auto creating it.
+    */
+    bool Eclipse3DProperties::hasRegion( const DeckItem& regionItem ) const {
+        if (regionItem.defaultApplied(0))
+            return m_intGridProperties.hasKeyword( m_defaultRegion );
+        else
+            return m_intGridProperties.hasDeckKeyword( getRegionName( regionItem ) );
     }
 
     std::vector< int > Eclipse3DProperties::getRegions( const std::string& keyword ) const {
         if( !this->hasDeckIntGridProperty( keyword ) ) return {};
 
-        const auto& property = this->getIntGridProperty( keyword );
-
-        std::set< int > regions( property.getData().begin(),
-                                 property.getData().end() );
+        return this->getRegionIndex( keyword )->regions();
+    }
 
-        return { regions.begin(), regions.end() };
+    std::shared_ptr< const RegionIndex > Eclipse3DProperties::getRegionIndex( const std::string& keyword ) const {
+        return this->getIntGridProperty( keyword ).regionIndex();
     }
 
     ///  Due to the post processor which might be applied to the GridProperty
@@ -595,6 +685,16 @@ namespace Opm {
         }
     }
 
+    bool Eclipse3DProperties::addConstantProperty( const std::string& keyword ) {
+        if (m_intGridProperties.supportsKeyword( keyword ))
+            return m_intGridProperties.addConstantKeyword( keyword );
+
+        if (m_doubleGridProperties.supportsKeyword( keyword ))
+            return m_doubleGridProperties.addConstantKeyword( keyword );
+
+        return false;
+    }
+
     /*
       Issues regarding initialization order and default values.
       =========================================================
@@ -704,58 +804,260 @@ namespace Opm {
 
 
 
+    namespace {
+
+        const std::set< std::string > operationKeywords = { "ADD", "COPY", "EQUALS", "MULTIPLY", "OPERATE",
+                                                            "ADDREG", "COPYREG", "EQUALREG", "MULTIREG" };
+
+        /*
+          The property names are used to order the tasks in scanSection(),
+          so they are normalized the same way as in GridProperties.
+        */
+        std::string propertyName( const std::string& keyword ) {
+            std::string name( keyword.begin(), std::find( keyword.begin(), keyword.end(), ' ' ) );
+            return uppercase( name, name );
+        }
+
+        /*
+          The EQUALS, ADD and MULTIPLY records on one property which are
+          collected in one task; a property is either int or double, so
+          only one of the lists is used.
+        */
+        struct PropertyEdits {
+            std::vector< GridProperty< int >::Edit > intEdits;
+            std::vector< GridProperty< double >::Edit > doubleEdits;
+        };
+    }
+
+
+    /*
+      The keywords are processed in deck order, but the operations on
+      properties are collected in a parallel::task_graph: an operation
+      is deferred to the graph if all the properties it reads or writes
+      exist already, and operations on different properties can then
+      run concurrently. Operations on the same property are still
+      applied in deck order.
+
+      Records which would create a property with a non constant default,
+      or which are invalid, can not be deferred; the pending operations
+      are then run before the record is processed directly - which gives
+      exactly the same result, and the same errors, as processing all
+      the records one by one.
+
+      EQUALS, ADD and MULTIPLY records which follow each other on the
+      same property - with no other operation on the property in
+      between - are collected in one task, which applies them in one
+      pass over the cells with GridProperty::apply().
+    */
     void Eclipse3DProperties::scanSection(const Section& section,
                                           const EclipseGrid& eclipseGrid) {
         BoxManager boxManager(eclipseGrid.getNX(),
                               eclipseGrid.getNY(),
                               eclipseGrid.getNZ());
+        parallel::task_graph tasks;
+        std::map< std::string, std::shared_ptr< PropertyEdits > > openEdits;
 
-        for( const auto& deckKeyword : section ) {
+        const auto addTask = [&]( std::function< void() > task, const std::vector< std::string >& properties ) {
+            for (const auto& name : properties)
+                openEdits.erase( name );
+
+            tasks.add( std::move( task ), properties );
+        };
+
+        const auto runTasks = [&]() {
+            openEdits.clear();
+            tasks.run();
+        };
 
-            if (supportsGridProperty(deckKeyword.name()) )
-                loadGridPropertyFromDeckKeyword( boxManager.getActiveBox(),
-                                                 deckKeyword);
-            else {
-                if (deckKeyword.name() == "BOX")
+        for( const auto& deckKeyword : section ) {
+            const std::string& keyword = deckKeyword.name();
+
+            if (supportsGridProperty( keyword )) {
+                if (addConstantProperty( keyword )) {
+                    const Box inputBox = boxManager.getActiveBox();
+                    addTask( [this, inputBox, &deckKeyword]() {
+                            loadGridPropertyFromDeckKeyword( inputBox, deckKeyword );
+                        }, { propertyName( keyword ) } );
+                } else {
+                    runTasks();
+                    loadGridPropertyFromDeckKeyword( boxManager.getActiveBox(),
+                                                     deckKeyword);
+                }
+            } else {
+                if (keyword == "BOX")
                     handleBOXKeyword(deckKeyword, boxManager);
 
-                else if (deckKeyword.name() == "ENDBOX")
+                else if (keyword == "ENDBOX")
                     handleENDBOXKeyword(boxManager);
 
+                else if (operationKeywords.count( keyword )) {
+                    const bool isEdit = keyword == "EQUALS" || keyword == "ADD" || keyword == "MULTIPLY";
+
+                    for( const auto& record : deckKeyword ) {
+                        std::vector< std::string > properties;
+                        PropertyEdits edit;
+                        bool deferred = false;
+                        try {
+                            deferred = planRecord( keyword, record, boxManager, properties );
+                            if (deferred && isEdit) {
+                                const std::string& field = record.getItem("field").get< std::string >(0);
+                                const Box& inputBox = boxManager.getActiveBox();
+
+                                if (m_doubleGridProperties.hasKeyword( field ))
+                                    edit.doubleEdits.push_back( m_doubleGridProperties.makeEdit( keyword, record, inputBox ) );
+                                else
+                                    edit.intEdits.push_back( m_intGridProperties.makeEdit( keyword, record, inputBox ) );
+                            }
+                        } catch (const std::exception&) {
+                            deferred = false;
+                        }
+
+                        if (deferred && isEdit) {
+                            const std::string field = record.getItem("field").get< std::string >(0);
+                            auto& edits = openEdits[ propertyName( field ) ];
+                            if (!edits) {
+                                auto newEdits = std::make_shared< PropertyEdits >();
+                                tasks.add( [this, field, newEdits]() {
+                                        if (!newEdits->doubleEdits.empty())
+                                            m_doubleGridProperties.applyEdits( field, newEdits->doubleEdits );
+                                        else
+                                            m_intGridProperties.applyEdits( field, newEdits->intEdits );
+                                    }, properties );
+                                edits = newEdits;
+                            }
+
+                            edits->doubleEdits.insert( edits->doubleEdits.end(), edit.doubleEdits.begin(), edit.doubleEdits.end() );
+                            edits->intEdits.insert( edits->intEdits.end(), edit.intEdits.begin(), edit.intEdits.end() );
+                        } else if (deferred) {
+                            BoxManager recordBoxManager = boxManager;
+                            addTask( [this, &keyword, &record, recordBoxManager]() mutable {
+                                    handleRecord( keyword, record, recordBoxManager );
+                                }, properties );
+                        } else {
+                            runTasks();
+                            handleRecord( keyword, record, boxManager );
+                        }
+                    }
+                }
+
+                boxManager.endKeyword();
+            }
+        }
+        runTasks();
+        boxManager.endSection();
+    }
+
+
+    /*
+      Checks if the record can be deferred to the task graph, i.e. all
+      the properties it uses exist - or are created here if they have a
+      constant default value - and the keyword box is valid. The keyword
+      box of the record is applied to boxManager, and the properties the
+      record reads or writes are returned in properties.
+    */
+    bool Eclipse3DProperties::planRecord( const std::string& keyword,
+                                          const DeckRecord& record,
+                                          BoxManager& boxManager,
+                                          std::vector< std::string >& properties) {
+
+        if (keyword == "ADD" || keyword == "MULTIPLY" || keyword == "EQUALS") {
+            const std::string& field = record.getItem("field").get< std::string >(0);
+            properties = { propertyName( field ) };
+
+            if (keyword == "EQUALS") {
+                if (!addConstantProperty( field ))
+                    return false;
+            } else if (!m_doubleGridProperties.hasKeyword( field ) && !m_intGridProperties.hasKeyword( field ))
+                return false;
 
-                else if (deckKeyword.name() == "COPY")
-                    handleCOPYKeyword( deckKeyword , boxManager);
+            return setKeywordBox( record, boxManager );
+        }
 
-                else if (deckKeyword.name() == "EQUALS")
-                    handleEQUALSKeyword(deckKeyword, boxManager);
+        if (keyword == "COPY") {
+            const std::string& src = record.getItem("src").get< std::string >(0);
+            const std::string& target = record.getItem("target").get< std::string >(0);
+            properties = { propertyName( src ), propertyName( target ) };
 
+            bool ready = false;
+            if (m_doubleGridProperties.hasKeyword( src ))
+                ready = m_doubleGridProperties.addConstantKeyword( target );
+            else if (m_intGridProperties.hasKeyword( src ))
+                ready = m_intGridProperties.addConstantKeyword( target );
 
-                else if (deckKeyword.name() == "ADD")
-                    handleADDKeyword( deckKeyword , boxManager);
+            return ready && setKeywordBox( record, boxManager );
+        }
 
-                else if (deckKeyword.name() == "MULTIPLY")
-                    handleMULTIPLYKeyword(deckKeyword, boxManager);
+        if (keyword == "OPERATE") {
+            const std::string& src = record.getItem("ARRAY").get< std::string >(0);
+            const std::string& target = record.getItem("TARGET_ARRAY").get< std::string >(0);
+            properties = { propertyName( src ), propertyName( target ) };
 
+            bool ready = false;
+            if (m_intGridProperties.supportsKeyword( target ))
+                ready = m_intGridProperties.hasKeyword( src ) && m_intGridProperties.addConstantKeyword( target );
+            else if (m_doubleGridProperties.supportsKeyword( target ))
+                ready = m_doubleGridProperties.hasKeyword( src ) && m_doubleGridProperties.addConstantKeyword( target );
 
-                else if (deckKeyword.name() == "EQUALREG")
-                    handleEQUALREGKeyword(deckKeyword);
+            return ready && setKeywordBox( record, boxManager );
+        }
 
-                else if (deckKeyword.name() == "ADDREG")
-                    handleADDREGKeyword(deckKeyword);
+        /* EQUALREG, ADDREG, MULTIREG and COPYREG */
+        const auto& regionItem = record.getItem("REGION_NAME");
+        const std::string& array = record.getItem("ARRAY").get< std::string >(0);
+        if (!hasRegion( regionItem ))
+            return false;
 
-                else if (deckKeyword.name() == "MULTIREG")
-                    handleMULTIREGKeyword(deckKeyword);
+        properties = { propertyName( array ), propertyName( getRegionName( regionItem ) ) };
 
-                else if (deckKeyword.name() == "COPYREG")
-                    handleCOPYREGKeyword(deckKeyword);
+        if (keyword == "ADDREG")
+            return m_intGridProperties.hasKeyword( array ) || m_doubleGridProperties.hasKeyword( array );
 
-                else if (deckKeyword.name() == "OPERATE")
-                    handleOPERATEKeyword( deckKeyword , boxManager);
+        if (keyword == "COPYREG") {
+            const std::string& target = record.getItem("TARGET_ARRAY").get< std::string >(0);
+            properties.push_back( propertyName( target ) );
 
-                boxManager.endKeyword();
-            }
+            if (m_intGridProperties.hasKeyword( array ))
+                return m_intGridProperties.addConstantKeyword( target );
+
+            if (m_doubleGridProperties.hasKeyword( array ))
+                return m_doubleGridProperties.addConstantKeyword( target );
+
+            return false;
         }
-        boxManager.endSection();
+
+        return addConstantProperty( array );
+    }
+
+
+    void Eclipse3DProperties::handleRecord( const std::string& keyword,
+                                            const DeckRecord& record,
+                                            BoxManager& boxManager) {
+        if (keyword == "COPY")
+            handleCOPYRecord( record , boxManager);
+
+        else if (keyword == "EQUALS")
+            handleEQUALSRecord(record, boxManager);
+
+        else if (keyword == "ADD")
+            handleADDRecord( record , boxManager);
+
+        else if (keyword == "MULTIPLY")
+            handleMULTIPLYRecord(record, boxManager);
+
+        else if (keyword == "EQUALREG")
+            handleEQUALREGRecord(record);
+
+        else if (keyword == "ADDREG")
+            handleADDREGRecord(record);
+
+        else if (keyword == "MULTIREG")
+            handleMULTIREGRecord(record);
+
+        else if (keyword == "COPYREG")
+            handleCOPYREGRecord(record);
+
+        else if (keyword == "OPERATE")
+            handleOPERATERecord( record , boxManager);
     }
 
 
@@ -776,94 +1078,81 @@ namespace Opm {
         boxManager.endInputBox();
     }
 
-    void Eclipse3DProperties::handleOPERATEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
+    void Eclipse3DProperties::handleOPERATERecord( const DeckRecord& record, BoxManager& boxManager) {
+        const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
 
-            if (m_intGridProperties.supportsKeyword( targetArray ))
-                m_intGridProperties.handleOPERATERecord( record  , boxManager);
-            else if (m_doubleGridProperties.supportsKeyword( targetArray ))
-                m_doubleGridProperties.handleOPERATERecord( record , boxManager);
-            else
-                throw std::invalid_argument("Fatal error processing OPERATE keyword - invalid/undefined keyword: " + targetArray);
-        }
+        if (m_intGridProperties.supportsKeyword( targetArray ))
+            m_intGridProperties.handleOPERATERecord( record  , boxManager);
+        else if (m_doubleGridProperties.supportsKeyword( targetArray ))
+            m_doubleGridProperties.handleOPERATERecord( record , boxManager);
+        else
+            throw std::invalid_argument("Fatal error processing OPERATE keyword - invalid/undefined keyword: " + targetArray);
     }
 
-    void Eclipse3DProperties::handleEQUALREGKeyword( const DeckKeyword& deckKeyword) {
-       for( const auto& record : deckKeyword ) {
-           const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-           auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+    void Eclipse3DProperties::handleEQUALREGRecord( const DeckRecord& record) {
+        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+        auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
 
-           if (m_intGridProperties.supportsKeyword( targetArray ))
-               m_intGridProperties.handleEQUALREGRecord( record , regionProperty );
-           else if (m_doubleGridProperties.supportsKeyword( targetArray ))
-               m_doubleGridProperties.handleEQUALREGRecord( record , regionProperty );
-           else
-               throw std::invalid_argument("Fatal error processing EQUALREG keyword - invalid/undefined keyword: " + targetArray);
-       }
-   }
+        if (m_intGridProperties.supportsKeyword( targetArray ))
+            m_intGridProperties.handleEQUALREGRecord( record , regionProperty );
+        else if (m_doubleGridProperties.supportsKeyword( targetArray ))
+            m_doubleGridProperties.handleEQUALREGRecord( record , regionProperty );
+        else
+            throw std::invalid_argument("Fatal error processing EQUALREG keyword - invalid/undefined keyword: " + targetArray);
+    }
 
 
-    void Eclipse3DProperties::handleADDREGKeyword( const DeckKeyword& deckKeyword) {
-       for( const auto& record : deckKeyword ) {
-           const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-           const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+    void Eclipse3DProperties::handleADDREGRecord( const DeckRecord& record) {
+        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+        const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
 
-           if (m_intGridProperties.hasKeyword( targetArray ))
-               m_intGridProperties.handleADDREGRecord( record , regionProperty );
-           else if (m_doubleGridProperties.hasKeyword( targetArray ))
-               m_doubleGridProperties.handleADDREGRecord( record , regionProperty );
-           else
-               throw std::invalid_argument("Fatal error processing ADDREG keyword - invalid/undefined keyword: " + targetArray);
-       }
+        if (m_intGridProperties.hasKeyword( targetArray ))
+            m_intGridProperties.handleADDREGRecord( record , regionProperty );
+        else if (m_doubleGridProperties.hasKeyword( targetArray ))
+            m_doubleGridProperties.handleADDREGRecord( record , regionProperty );
+        else
+            throw std::invalid_argument("Fatal error processing ADDREG keyword - invalid/undefined keyword: " + targetArray);
     }
 
 
 
-    void Eclipse3DProperties::handleMULTIREGKeyword( const DeckKeyword& deckKeyword) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
-            const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+    void Eclipse3DProperties::handleMULTIREGRecord( const DeckRecord& record) {
+        const std::string& targetArray = record.getItem("ARRAY").get< std::string >(0);
+        const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
 
-           if (m_intGridProperties.supportsKeyword( targetArray ))
-               m_intGridProperties.handleMULTIREGRecord( record , regionProperty );
-           else if (m_doubleGridProperties.supportsKeyword( targetArray ))
-               m_doubleGridProperties.handleMULTIREGRecord( record , regionProperty );
-           else
-               throw std::invalid_argument("Fatal error processing MULTIREG keyword - invalid/undefined keyword: " + targetArray);
-        }
+        if (m_intGridProperties.supportsKeyword( targetArray ))
+            m_intGridProperties.handleMULTIREGRecord( record , regionProperty );
+        else if (m_doubleGridProperties.supportsKeyword( targetArray ))
+            m_doubleGridProperties.handleMULTIREGRecord( record , regionProperty );
+        else
+            throw std::invalid_argument("Fatal error processing MULTIREG keyword - invalid/undefined keyword: " + targetArray);
     }
 
 
-    void Eclipse3DProperties::handleCOPYREGKeyword( const DeckKeyword& deckKeyword) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& srcArray = record.getItem("ARRAY").get< std::string >(0);
-            const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
+    void Eclipse3DProperties::handleCOPYREGRecord( const DeckRecord& record) {
+        const std::string& srcArray = record.getItem("ARRAY").get< std::string >(0);
+        const auto& regionProperty = getRegion( record.getItem("REGION_NAME") );
 
-            if (m_intGridProperties.hasKeyword( srcArray ))
-                m_intGridProperties.handleCOPYREGRecord( record, regionProperty );
-            else if (m_doubleGridProperties.hasKeyword( srcArray ))
-                m_doubleGridProperties.handleCOPYREGRecord( record, regionProperty );
-            else
-                throw std::invalid_argument("Fatal error processing COPYREG keyword - invalid/undefined keyword: " + srcArray);
-        }
+        if (m_intGridProperties.hasKeyword( srcArray ))
+            m_intGridProperties.handleCOPYREGRecord( record, regionProperty );
+        else if (m_doubleGridProperties.hasKeyword( srcArray ))
+            m_doubleGridProperties.handleCOPYREGRecord( record, regionProperty );
+        else
+            throw std::invalid_argument("Fatal error processing COPYREG keyword - invalid/undefined keyword: " + srcArray);
     }
 
 
 
 
-    void Eclipse3DProperties::handleMULTIPLYKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& field = record.getItem("field").get< std::string >(0);
-
-            if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleMULTIPLYRecord( record , boxManager );
-            else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleMULTIPLYRecord( record , boxManager );
-            else
-                throw std::invalid_argument("Fatal error processing MULTIPLY keyword. Tried to shift not defined keyword " + field);
+    void Eclipse3DProperties::handleMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager) {
+        const std::string& field = record.getItem("field").get< std::string >(0);
 
-        }
+        if (m_doubleGridProperties.hasKeyword( field ))
+            m_doubleGridProperties.handleMULTIPLYRecord( record , boxManager );
+        else if (m_intGridProperties.hasKeyword( field ))
+            m_intGridProperties.handleMULTIPLYRecord( record , boxManager );
+        else
+            throw std::invalid_argument("Fatal error processing MULTIPLY keyword. Tried to shift not defined keyword " + field);
     }
 
 
@@ -872,48 +1161,39 @@ namespace Opm {
       some state dependent semantics regarding endpoint scaling arrays
       in the PROPS section. That is not supported.
     */
-    void Eclipse3DProperties::handleADDKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& field = record.getItem("field").get< std::string >(0);
-
-            if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleADDRecord( record , boxManager );
-            else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleADDRecord( record , boxManager );
-            else
-                throw std::invalid_argument("Fatal error processing ADD keyword. Tried to shift not defined keyword " + field);
-
-        }
+    void Eclipse3DProperties::handleADDRecord( const DeckRecord& record, BoxManager& boxManager) {
+        const std::string& field = record.getItem("field").get< std::string >(0);
+
+        if (m_doubleGridProperties.hasKeyword( field ))
+            m_doubleGridProperties.handleADDRecord( record , boxManager );
+        else if (m_intGridProperties.hasKeyword( field ))
+            m_intGridProperties.handleADDRecord( record , boxManager );
+        else
+            throw std::invalid_argument("Fatal error processing ADD keyword. Tried to shift not defined keyword " + field);
     }
 
 
-    void Eclipse3DProperties::handleCOPYKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& field = record.getItem("src").get< std::string >(0);
+    void Eclipse3DProperties::handleCOPYRecord( const DeckRecord& record, BoxManager& boxManager) {
+        const std::string& field = record.getItem("src").get< std::string >(0);
 
-            if (m_doubleGridProperties.hasKeyword( field ))
-                m_doubleGridProperties.handleCOPYRecord( record , boxManager );
-            else if (m_intGridProperties.hasKeyword( field ))
-                m_intGridProperties.handleCOPYRecord( record , boxManager );
-            else
-                throw std::invalid_argument("Fatal error processing COPY keyword. Tried to copy not defined keyword " + field);
-
-        }
+        if (m_doubleGridProperties.hasKeyword( field ))
+            m_doubleGridProperties.handleCOPYRecord( record , boxManager );
+        else if (m_intGridProperties.hasKeyword( field ))
+            m_intGridProperties.handleCOPYRecord( record , boxManager );
+        else
+            throw std::invalid_argument("Fatal error processing COPY keyword. Tried to copy not defined keyword " + field);
     }
 
 
-    void Eclipse3DProperties::handleEQUALSKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager) {
-        for( const auto& record : deckKeyword ) {
-            const std::string& field = record.getItem("field").get< std::string >(0);
-
-            if (m_doubleGridProperties.supportsKeyword( field ))
-                m_doubleGridProperties.handleEQUALSRecord( record , boxManager );
-            else if (m_intGridProperties.supportsKeyword( field ))
-                m_intGridProperties.handleEQUALSRecord( record , boxManager );
-            else
-                throw std::invalid_argument("Fatal error processing EQUALS keyword. Tried to assign not defined keyword " + field);
+    void Eclipse3DProperties::handleEQUALSRecord( const DeckRecord& record, BoxManager& boxManager) {
+        const std::string& field = record.getItem("field").get< std::string >(0);
 
-        }
+        if (m_doubleGridProperties.supportsKeyword( field ))
+            m_doubleGridProperties.handleEQUALSRecord( record , boxManager );
+        else if (m_intGridProperties.supportsKeyword( field ))
+            m_intGridProperties.handleEQUALSRecord( record , boxManager );
+        else
+            throw std::invalid_argument("Fatal error processing EQUALS keyword. Tried to assign not defined keyword " + field);
     }
 
 
@@ -926,9 +1206,19 @@ namespace Opm {
     }
 
 
-    void Eclipse3DProperties::setKeywordBox( const DeckKeyword& deckKeyword,
-                                           const DeckRecord& deckRecord,
-                                           BoxManager& boxManager) {
+    void Eclipse3DProperties::compressToActive( const EclipseGrid& grid ) {
+        m_intGridProperties.compressToActive( grid );
+        m_doubleGridProperties.compressToActive( grid );
+    }
+
+
+    /*
+      Applies the BOX items of the record to boxManager, the same way
+      as the GridProperties handlers do. Returns false if the box is
+      only partially specified.
+    */
+    bool Eclipse3DProperties::setKeywordBox( const DeckRecord& deckRecord,
+                                             BoxManager& boxManager) const {
         const auto& I1Item = deckRecord.getItem("I1");
         const auto& I2Item = deckRecord.getItem("I2");
         const auto& J1Item = deckRecord.getItem("J1");
@@ -963,10 +1253,8 @@ namespace Opm {
                                       J2Item.get< int >(0) - 1,
                                       K1Item.get< int >(0) - 1,
                                       K2Item.get< int >(0) - 1);
-        } else if (setCount != 0) {
-            std::string msg = "BOX modifiers on keywords must be either "
-                "specified completely or not at all. Ignoring.";
-            m_intGridProperties.getMessageContainer().error(deckKeyword.getFileName() + std::to_string(deckKeyword.getLineNumber()) + msg);
         }
+
+        return setCount == 0 || setCount == 6;
     }
 }
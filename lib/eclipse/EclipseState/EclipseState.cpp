@@ -48,7 +48,7 @@
 
 namespace Opm {
 
-    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext) :
+    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext, PropertyStorage propertyStorage) :
         m_parseContext(      parseContext ),
         m_tables(            deck ),
         m_runspec(           deck ),
@@ -79,6 +79,9 @@ namespace Opm {
         m_messageContainer.appendMessages(m_tables.getMessageContainer());
         m_messageContainer.appendMessages(m_inputGrid.getMessageContainer());
         m_messageContainer.appendMessages(m_eclipseProperties.getMessageContainer());
+
+        if (propertyStorage == PropertyStorage::ActiveCells)
+            m_eclipseProperties.compressToActive( m_inputGrid );
     }
 
     const UnitSystem& EclipseState::getDeckUnitSystem() const {
@@ -237,37 +240,27 @@ namespace Opm {
         for (const auto& keyword : deck) {
 
             if (keyword.isKeyword<MULTFLT>()) {
+                /*
+                  MULTFLT keywords found in the SCHEDULE section apply the
+                  transmissibility modifiers cumulatively - i.e. the current
+                  transmissibility across the fault is *multiplied* with the
+                  newly entered MULTFLT value, and the resulting
+                  transmissibility multiplier for the fault is the product of
+                  the newly entered value and the current value. The new
+                  factors of all the records are applied to the TransMult
+                  object in one pass.
+                */
+                std::vector< std::pair< const Fault*, double > > faultFactors;
                 for (const auto& record : keyword) {
                     const std::string& faultName = record.getItem<MULTFLT::fault>().get< std::string >(0);
                     auto& fault = m_faults.getFault( faultName );
                     double tmpMultFlt = record.getItem<MULTFLT::factor>().get< double >(0);
-                    double oldMultFlt = fault.getTransMult( );
-                    double newMultFlt = oldMultFlt * tmpMultFlt;
-
-                    /*
-                      This extremely contrived way of doing it is because of difference in
-                      behavior and section awareness between the Fault object and the
-                      Transmult object:
-
-                      1. MULTFLT keywords found in the SCHEDULE section should apply the
-                         transmissibility modifiers cumulatively - i.e. the current
-                         transmissibility across the fault should be *multiplied* with the
-                         newly entered MULTFLT value, and the resulting transmissibility
-                         multplier for this fault should be the product of the newly
-                         entered value and the current value.
-
-                      2. The TransMult::applyMULTFLT() implementation will *multiply* the
-                         transmissibility across a face with the value in the fault
-                         object. Hence the current value has already been multiplied in;
-                         we therefor first *set* the MULTFLT value to the new value, then
-                         apply it to the TransMult object and then eventually update the
-                         MULTFLT value in the fault instance.
-
-                    */
-                    fault.setTransMult( tmpMultFlt );
-                    m_transMult.applyMULTFLT( fault );
-                    fault.setTransMult( newMultFlt );
+
+                    fault.setTransMult( fault.getTransMult() * tmpMultFlt );
+                    faultFactors.emplace_back( &fault , tmpMultFlt );
                 }
+
+                m_transMult.applyMULTFLT( faultFactors );
             }
         }
     }
@@ -46,7 +46,6 @@ namespace Opm {
         m_stride[2] = m_dims[0] * m_dims[1];
 
         m_isGlobal = true;
-        initIndexList();
     }
 
 
@@ -71,8 +70,6 @@ namespace Opm {
             m_isGlobal = true;
         else
             m_isGlobal = false;
-
-        initIndexList();
     }
 
 
@@ -103,38 +100,100 @@ namespace Opm {
     }
 
 
+    size_t Box::getOffset(size_t idim) const {
+        if (idim >= 3)
+            throw std::invalid_argument("The input dimension value is invalid");
+
+        return m_offset[idim];
+    }
+
+
 
-    std::vector<size_t>::const_iterator Box::begin() const {
-        return m_indexList.begin();
+    size_t Box::globalIndex( size_t i, size_t j, size_t k ) const {
+        return (i + m_offset[0]) * m_stride[0]
+             + (j + m_offset[1]) * m_stride[1]
+             + (k + m_offset[2]) * m_stride[2];
     }
 
-    std::vector<size_t>::const_iterator Box::end() const {
-        return m_indexList.end();
+
+    Box::const_iterator::const_iterator( const Box* box, size_t pos ) :
+        m_box( box ),
+        m_pos( pos ),
+        m_global( box->globalIndex( 0, 0, 0 ) )
+    {}
+
+
+    Box::const_iterator& Box::const_iterator::operator++() {
+        m_pos++;
+        m_i++;
+        if (m_i < m_box->m_dims[0]) {
+            m_global++;
+            return *this;
+        }
+
+        m_i = 0;
+        m_j++;
+        if (m_j == m_box->m_dims[1]) {
+            m_j = 0;
+            m_k++;
+        }
+        m_global = m_box->globalIndex( m_i, m_j, m_k );
+        return *this;
+    }
+
+
+    Box::const_iterator Box::const_iterator::operator++( int ) {
+        const_iterator copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+
+    Box::const_iterator Box::begin() const {
+        return const_iterator( this, 0 );
+    }
+
+    Box::const_iterator Box::end() const {
+        return const_iterator( this, size() );
     }
 
 
     const std::vector<size_t>& Box::getIndexList() const {
+        if (m_indexList.size() != size())
+            m_indexList.assign( begin(), end() );
+
         return m_indexList;
     }
 
 
-    void Box::initIndexList() {
-        m_indexList.resize( size() );
+    void Box::forEachRange( const std::function< void( size_t, size_t ) >& f ) const {
+        if (size() == 0)
+            return;
 
-        size_t ii,ij,ik;
-        size_t l = 0;
+        /*
+          The I-rows are contiguous in the global grid if the box spans
+          the full I dimension, and the J-planes as well if it also
+          spans the full J dimension.
+        */
+        const bool full_i = m_dims[0] == m_stride[1];
+        const bool full_j = full_i && m_dims[1] * m_stride[1] == m_stride[2];
 
-        for (ik=0; ik < m_dims[2]; ik++) {
-            size_t k = ik + m_offset[2];
-            for (ij=0; ij < m_dims[1]; ij++) {
-                size_t j = ij + m_offset[1];
-                for (ii=0; ii < m_dims[0]; ii++) {
-                    size_t i = ii + m_offset[0];
-                    size_t g = i * m_stride[0] + j*m_stride[1] + k*m_stride[2];
+        if (full_j) {
+            const size_t begin = globalIndex( 0, 0, 0 );
+            f( begin, begin + size() );
+            return;
+        }
+
+        for (size_t k = 0; k < m_dims[2]; k++) {
+            if (full_i) {
+                const size_t begin = globalIndex( 0, 0, k );
+                f( begin, begin + m_dims[0] * m_dims[1] );
+                continue;
+            }
 
-                    m_indexList[l] = g;
-                    l++;
-                }
+            for (size_t j = 0; j < m_dims[1]; j++) {
+                const size_t begin = globalIndex( 0, j, k );
+                f( begin, begin + m_dims[0] );
             }
         }
     }
@@ -0,0 +1,272 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include <opm/parser/eclipse/EclipseState/Grid/CartesianGeometry.hpp>
+
+namespace Opm {
+
+    CartesianGeometry::CartesianGeometry( input in, size_t nx, size_t ny, size_t nz ) :
+        m_input( in ),
+        m_nx( nx ), m_ny( ny ), m_nz( nz ),
+        m_px( ( nx + 1 ) * ( ny + 1 ) ),
+        m_py( ( nx + 1 ) * ( ny + 1 ) )
+    {}
+
+
+    CartesianGeometry CartesianGeometry::newDTOPS( size_t nx, size_t ny, size_t nz,
+                                                   const std::vector< double >& dx,
+                                                   const std::vector< double >& dy,
+                                                   const std::vector< double >& dz,
+                                                   const std::vector< double >& tops ) {
+        CartesianGeometry geometry( input::DTOPS, nx, ny, nz );
+        geometry.m_dx = dx;
+        geometry.m_dy = dy;
+        geometry.m_dz = dz;
+        geometry.m_tops = tops;
+
+        /*
+          Every cell is a DX*DY*DZ box of its own, as in ERT: within a
+          layer the cells of row j are placed by accumulating DX along
+          the row, and the cells of column i by accumulating DY along
+          the column. Neighbouring cells need not share corners when
+          DX varies with j or DY with i.
+        */
+        geometry.m_x0.resize( nx * ny * nz );
+        geometry.m_y0.resize( nx * ny * nz );
+        for( size_t k = 0; k < nz; k++ ) {
+            const size_t layer = k * nx * ny;
+            for( size_t j = 0; j < ny; j++ ) {
+                double x = 0;
+                for( size_t i = 0; i < nx; i++ ) {
+                    geometry.m_x0[ layer + i + j * nx ] = x;
+                    x += dx[ layer + i + j * nx ];
+                }
+            }
+
+            for( size_t i = 0; i < nx; i++ ) {
+                double y = 0;
+                for( size_t j = 0; j < ny; j++ ) {
+                    geometry.m_y0[ layer + i + j * nx ] = y;
+                    y += dy[ layer + i + j * nx ];
+                }
+            }
+        }
+
+        /*
+          The pillars are only used for the COORD export, and are
+          placed by accumulating the cell sizes of the top layer; the
+          last row and column of pillars use the values of the last
+          row and column of cells.
+        */
+        if( nx > 0 && ny > 0 ) {
+            for( size_t j = 0; j <= ny; j++ ) {
+                double x = 0;
+                for( size_t i = 0; i <= nx; i++ ) {
+                    geometry.m_px[ i + j * ( nx + 1 ) ] = x;
+                    if( i < nx ) x += dx[ i + nx * std::min( j, ny - 1 ) ];
+                }
+            }
+
+            for( size_t i = 0; i <= nx; i++ ) {
+                double y = 0;
+                for( size_t j = 0; j <= ny; j++ ) {
+                    geometry.m_py[ i + j * ( nx + 1 ) ] = y;
+                    if( j < ny ) y += dy[ std::min( i, nx - 1 ) + nx * j ];
+                }
+            }
+        }
+
+        return geometry;
+    }
+
+
+    CartesianGeometry CartesianGeometry::newDVDEPTHZ( size_t nx, size_t ny, size_t nz,
+                                                      const std::vector< double >& dxv,
+                                                      const std::vector< double >& dyv,
+                                                      const std::vector< double >& dzv,
+                                                      const std::vector< double >& depthz ) {
+        CartesianGeometry geometry( input::DVDEPTHZ, nx, ny, nz );
+        geometry.m_dx = dxv;
+        geometry.m_dy = dyv;
+        geometry.m_dz = dzv;
+        geometry.m_tops = depthz;
+
+        std::vector< double > xs( nx + 1, 0 );
+        std::vector< double > ys( ny + 1, 0 );
+        for( size_t i = 0; i < nx; i++ ) xs[ i + 1 ] = xs[ i ] + dxv[ i ];
+        for( size_t j = 0; j < ny; j++ ) ys[ j + 1 ] = ys[ j ] + dyv[ j ];
+
+        for( size_t j = 0; j <= ny; j++ ) {
+            for( size_t i = 0; i <= nx; i++ ) {
+                geometry.m_px[ i + j * ( nx + 1 ) ] = xs[ i ];
+                geometry.m_py[ i + j * ( nx + 1 ) ] = ys[ j ];
+            }
+        }
+
+        geometry.m_layers.assign( nz + 1, 0 );
+        for( size_t k = 0; k < nz; k++ )
+            geometry.m_layers[ k + 1 ] = geometry.m_layers[ k ] + dzv[ k ];
+
+        return geometry;
+    }
+
+
+    size_t CartesianGeometry::pillar( size_t i, size_t j, size_t c ) const {
+        return ( i + ( c & 1 ) ) + ( j + ( ( c >> 1 ) & 1 ) ) * ( this->m_nx + 1 );
+    }
+
+    double CartesianGeometry::top( size_t i, size_t j, size_t k, size_t c ) const {
+        if( this->m_input == input::DTOPS )
+            return this->m_tops[ i + this->m_nx * ( j + this->m_ny * k ) ];
+
+        return this->m_tops[ this->pillar( i, j, c ) ] + this->m_layers[ k ];
+    }
+
+    double CartesianGeometry::bottom( size_t i, size_t j, size_t k, size_t c ) const {
+        if( this->m_input == input::DTOPS ) {
+            const size_t g = i + this->m_nx * ( j + this->m_ny * k );
+            return this->m_tops[ g ] + this->m_dz[ g ];
+        }
+
+        return this->m_tops[ this->pillar( i, j, c ) ] + this->m_layers[ k + 1 ];
+    }
+
+
+    CartesianGeometry::corners CartesianGeometry::getCorners( size_t i, size_t j, size_t k ) const {
+        corners p;
+        if( this->m_input == input::DTOPS ) {
+            const size_t g = i + this->m_nx * ( j + this->m_ny * k );
+            for( size_t c = 0; c < 4; c++ ) {
+                const double x = this->m_x0[ g ] + ( c & 1 ) * this->m_dx[ g ];
+                const double y = this->m_y0[ g ] + ( ( c >> 1 ) & 1 ) * this->m_dy[ g ];
+
+                p[ c ]     = {{ x, y, this->top( i, j, k, c ) }};
+                p[ c + 4 ] = {{ x, y, this->bottom( i, j, k, c ) }};
+            }
+
+            return p;
+        }
+
+        for( size_t c = 0; c < 4; c++ ) {
+            const size_t pillar = this->pillar( i, j, c );
+            const double x = this->m_px[ pillar ];
+            const double y = this->m_py[ pillar ];
+
+            p[ c ]     = {{ x, y, this->top( i, j, k, c ) }};
+            p[ c + 4 ] = {{ x, y, this->bottom( i, j, k, c ) }};
+        }
+
+        return p;
+    }
+
+    CartesianGeometry::corners CartesianGeometry::getCorners( size_t globalIndex ) const {
+        const size_t i = globalIndex % this->m_nx;
+        const size_t j = ( globalIndex / this->m_nx ) % this->m_ny;
+        const size_t k = globalIndex / ( this->m_nx * this->m_ny );
+        return this->getCorners( i, j, k );
+    }
+
+
+    void CartesianGeometry::exportCOORD( std::vector< double >& coord ) const {
+        const size_t nx = this->m_nx;
+        const size_t ny = this->m_ny;
+        coord.resize( 6 * ( nx + 1 ) * ( ny + 1 ) );
+
+        /*
+          A DTOPS pillar spans the depth range of the cells in the (up
+          to four) columns around it.
+        */
+        std::vector< double > zmin( ( nx + 1 ) * ( ny + 1 ), 0 );
+        std::vector< double > zmax( ( nx + 1 ) * ( ny + 1 ), 1 );
+        if( this->m_input == input::DTOPS ) {
+            std::vector< bool > seen( zmin.size(), false );
+            for( size_t g = 0; g < this->m_tops.size(); g++ ) {
+                const size_t i = g % nx;
+                const size_t j = ( g / nx ) % ny;
+                const double top = this->m_tops[ g ];
+                const double bottom = top + this->m_dz[ g ];
+
+                for( size_t c = 0; c < 4; c++ ) {
+                    const size_t p = this->pillar( i, j, c );
+                    if( !seen[ p ] ) {
+                        zmin[ p ] = std::min( top, bottom );
+                        zmax[ p ] = std::max( top, bottom );
+                        seen[ p ] = true;
+                    } else {
+                        zmin[ p ] = std::min( zmin[ p ], std::min( top, bottom ) );
+                        zmax[ p ] = std::max( zmax[ p ], std::max( top, bottom ) );
+                    }
+                }
+            }
+        }
+
+        for( size_t p = 0; p < ( nx + 1 ) * ( ny + 1 ); p++ ) {
+            double z0 = zmin[ p ], z1 = zmax[ p ];
+            if( this->m_input == input::DVDEPTHZ ) {
+                z0 = this->m_tops[ p ];
+                z1 = this->m_tops[ p ] + this->m_layers.back();
+            }
+
+            coord[ 6 * p + 0 ] = this->m_px[ p ];
+            coord[ 6 * p + 1 ] = this->m_py[ p ];
+            coord[ 6 * p + 2 ] = z0;
+            coord[ 6 * p + 3 ] = this->m_px[ p ];
+            coord[ 6 * p + 4 ] = this->m_py[ p ];
+            coord[ 6 * p + 5 ] = z1;
+        }
+    }
+
+
+    void CartesianGeometry::exportZCORN( std::vector< double >& zcorn ) const {
+        const size_t nx = this->m_nx;
+        const size_t ny = this->m_ny;
+        zcorn.resize( 8 * nx * ny * this->m_nz );
+
+        for( size_t k = 0; k < this->m_nz; k++ ) {
+            for( size_t j = 0; j < ny; j++ ) {
+                for( size_t i = 0; i < nx; i++ ) {
+                    for( size_t c = 0; c < 4; c++ ) {
+                        const size_t di = c & 1;
+                        const size_t dj = ( c >> 1 ) & 1;
+                        const size_t index = ( 2 * i + di ) + ( 2 * j + dj ) * 2 * nx + 2 * k * 4 * nx * ny;
+
+                        zcorn[ index ] = this->top( i, j, k, c );
+                        zcorn[ index + 4 * nx * ny ] = this->bottom( i, j, k, c );
+                    }
+                }
+            }
+        }
+    }
+
+
+    ecl_grid_type* CartesianGeometry::allocGrid( const int* actnum ) const {
+        if( this->m_input == input::DTOPS )
+            return ecl_grid_alloc_dx_dy_dz_tops( this->m_nx, this->m_ny, this->m_nz,
+                                                 this->m_dx.data(), this->m_dy.data(),
+                                                 this->m_dz.data(), this->m_tops.data(),
+                                                 actnum );
+
+        return ecl_grid_alloc_dxv_dyv_dzv_depthz( this->m_nx, this->m_ny, this->m_nz,
+                                                  this->m_dx.data(), this->m_dy.data(),
+                                                  this->m_dz.data(), this->m_tops.data(),
+                                                  actnum );
+    }
+}
@@ -0,0 +1,246 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
+
+namespace Opm {
+
+namespace {
+
+    using point = std::array< double, 3 >;
+
+    /* six times the signed volume of the tetrahedron a,b,c,d */
+    double tetrahedron( const point& a, const point& b, const point& c, const point& d ) {
+        const point u = {{ b[0] - a[0], b[1] - a[1], b[2] - a[2] }};
+        const point v = {{ c[0] - a[0], c[1] - a[1], c[2] - a[2] }};
+        const point w = {{ d[0] - a[0], d[1] - a[1], d[2] - a[2] }};
+
+        return u[0] * ( v[1] * w[2] - v[2] * w[1] )
+             - u[1] * ( v[0] * w[2] - v[2] * w[0] )
+             + u[2] * ( v[0] * w[1] - v[1] * w[0] );
+    }
+
+    /*
+      A point is inside the tetrahedron if replacing any one of the
+      vertices with the point does not change the orientation; points
+      on the faces are inside, and degenerate tetrahedra contain
+      nothing.
+    */
+    bool inside( const point& a, const point& b, const point& c, const point& d, const point& p ) {
+        const double volume = tetrahedron( a, b, c, d );
+        if( volume == 0 ) return false;
+
+        const double sign = volume > 0 ? 1 : -1;
+        const double tolerance = -1e-12 * std::fabs( volume );
+
+        return sign * tetrahedron( p, b, c, d ) >= tolerance
+            && sign * tetrahedron( a, p, c, d ) >= tolerance
+            && sign * tetrahedron( a, b, p, d ) >= tolerance
+            && sign * tetrahedron( a, b, c, p ) >= tolerance;
+    }
+
+    /*
+      The split of the cell in six tetrahedra around the 0-7 diagonal.
+      Every face is split along the diagonal through corner 0 or 7, so
+      neighbouring cells split their common face the same way. This is
+      not the decomposition GridGeometry::cellVolume() uses, which
+      averages both splits of every face; for cells with non-planar
+      faces the two may differ slightly close to the faces.
+    */
+    const size_t tetrahedra[ 6 ][ 3 ] = {
+        { 1, 3, 7 }, { 1, 7, 5 }, { 2, 6, 7 }, { 2, 7, 3 }, { 4, 5, 7 }, { 4, 7, 6 }
+    };
+
+}
+
+    CellLocator::CellLocator( size_t nx, size_t ny, size_t nz,
+                              const GridGeometry::corner_function& cell_corners ) :
+        m_nx( nx ), m_ny( ny ), m_nz( nz ),
+        m_corners( cell_corners ),
+        m_column_box( nx * ny ),
+        m_max_bottom( nx * ny * nz ),
+        m_min_top( nx * ny * nz ),
+        m_bx( 0 ), m_by( 0 ),
+        m_xmin( 0 ), m_ymin( 0 ), m_dx( 1 ), m_dy( 1 )
+    {
+        const size_t columns = nx * ny;
+        if( columns == 0 || nz == 0 ) return;
+
+        const double inf = std::numeric_limits< double >::infinity();
+
+        /* The column boxes and depth ranges, one column at a time in parallel. */
+        parallel::for_ranges( columns, [&]( size_t begin, size_t end ) {
+            GridGeometry::corners p;
+            std::vector< double > top( nz );
+
+            for( size_t column = begin; column < end; column++ ) {
+                const size_t i = column % nx;
+                const size_t j = column / nx;
+                const size_t offset = column * nz;
+                std::array< double, 4 > box = {{ inf, -inf, inf, -inf }};
+                double max_bottom = -inf;
+
+                for( size_t k = 0; k < nz; k++ ) {
+                    this->m_corners( i, j, k, p );
+
+                    double zmin = inf, zmax = -inf;
+                    for( const auto& corner : p ) {
+                        box[0] = std::min( box[0], corner[0] );
+                        box[1] = std::max( box[1], corner[0] );
+                        box[2] = std::min( box[2], corner[1] );
+                        box[3] = std::max( box[3], corner[1] );
+                        zmin = std::min( zmin, corner[2] );
+                        zmax = std::max( zmax, corner[2] );
+                    }
+
+                    top[ k ] = zmin;
+                    max_bottom = std::max( max_bottom, zmax );
+                    this->m_max_bottom[ offset + k ] = max_bottom;
+                }
+
+                double min_top = inf;
+                for( size_t k = nz; k > 0; k-- ) {
+                    min_top = std::min( min_top, top[ k - 1 ] );
+                    this->m_min_top[ offset + k - 1 ] = min_top;
+                }
+
+                this->m_column_box[ column ] = box;
+            }
+        }, std::max< size_t >( 1, 1024 / nz ) );
+
+        /* Bin the columns in a bucket grid of the same size as the grid. */
+        double xmax = -inf, ymax = -inf;
+        this->m_xmin = inf;
+        this->m_ymin = inf;
+        for( const auto& box : this->m_column_box ) {
+            this->m_xmin = std::min( this->m_xmin, box[0] );
+            xmax = std::max( xmax, box[1] );
+            this->m_ymin = std::min( this->m_ymin, box[2] );
+            ymax = std::max( ymax, box[3] );
+        }
+
+        this->m_bx = nx;
+        this->m_by = ny;
+        this->m_dx = xmax > this->m_xmin ? ( xmax - this->m_xmin ) / this->m_bx : 1;
+        this->m_dy = ymax > this->m_ymin ? ( ymax - this->m_ymin ) / this->m_by : 1;
+
+        const auto bucket_range = [this]( const std::array< double, 4 >& box ) {
+            const auto bin = [this]( double value, double min, double step, size_t count ) {
+                const auto b = static_cast< size_t >( std::max( 0.0, ( value - min ) / step ) );
+                return std::min( b, count - 1 );
+            };
+
+            return std::array< size_t, 4 >{{ bin( box[0], this->m_xmin, this->m_dx, this->m_bx ),
+                                             bin( box[1], this->m_xmin, this->m_dx, this->m_bx ),
+                                             bin( box[2], this->m_ymin, this->m_dy, this->m_by ),
+                                             bin( box[3], this->m_ymin, this->m_dy, this->m_by ) }};
+        };
+
+        this->m_bucket_offset.assign( this->m_bx * this->m_by + 1, 0 );
+        for( const auto& box : this->m_column_box ) {
+            const auto range = bucket_range( box );
+            for( size_t bj = range[2]; bj <= range[3]; bj++ )
+                for( size_t bi = range[0]; bi <= range[1]; bi++ )
+                    this->m_bucket_offset[ this->bucket( bi, bj ) + 1 ]++;
+        }
+
+        for( size_t b = 0; b < this->m_bx * this->m_by; b++ )
+            this->m_bucket_offset[ b + 1 ] += this->m_bucket_offset[ b ];
+
+        this->m_bucket_columns.resize( this->m_bucket_offset.back() );
+        auto fill = this->m_bucket_offset;
+        for( size_t column = 0; column < columns; column++ ) {
+            const auto range = bucket_range( this->m_column_box[ column ] );
+            for( size_t bj = range[2]; bj <= range[3]; bj++ )
+                for( size_t bi = range[0]; bi <= range[1]; bi++ )
+                    this->m_bucket_columns[ fill[ this->bucket( bi, bj ) ]++ ] = column;
+        }
+    }
+
+
+    size_t CellLocator::bucket( size_t bi, size_t bj ) const {
+        return bi + bj * this->m_bx;
+    }
+
+
+    bool CellLocator::contains( size_t i, size_t j, size_t k, double x, double y, double z ) const {
+        GridGeometry::corners p;
+        this->m_corners( i, j, k, p );
+
+        const point target = {{ x, y, z }};
+        for( const auto& t : tetrahedra ) {
+            if( inside( p[0], p[ t[0] ], p[ t[1] ], p[ t[2] ], target ) )
+                return true;
+        }
+
+        return false;
+    }
+
+
+    int CellLocator::findCell( double x, double y, double z ) const {
+        if( this->m_bucket_offset.empty() ) return -1;
+
+        const double bx = ( x - this->m_xmin ) / this->m_dx;
+        const double by = ( y - this->m_ymin ) / this->m_dy;
+        if( !( bx >= 0 && bx <= this->m_bx && by >= 0 && by <= this->m_by ) )
+            return -1;
+
+        const size_t bi = std::min( static_cast< size_t >( bx ), this->m_bx - 1 );
+        const size_t bj = std::min( static_cast< size_t >( by ), this->m_by - 1 );
+        const size_t b = this->bucket( bi, bj );
+
+        for( size_t n = this->m_bucket_offset[ b ]; n < this->m_bucket_offset[ b + 1 ]; n++ ) {
+            const size_t column = this->m_bucket_columns[ n ];
+            const auto& box = this->m_column_box[ column ];
+            if( x < box[0] || x > box[1] || y < box[2] || y > box[3] )
+                continue;
+
+            /* The layers [k0,k1) are the only ones which can contain z. */
+            const auto max_bottom = this->m_max_bottom.begin() + column * this->m_nz;
+            const auto min_top = this->m_min_top.begin() + column * this->m_nz;
+            const size_t k0 = std::lower_bound( max_bottom, max_bottom + this->m_nz, z ) - max_bottom;
+            const size_t k1 = std::upper_bound( min_top, min_top + this->m_nz, z ) - min_top;
+
+            const size_t i = column % this->m_nx;
+            const size_t j = column / this->m_nx;
+            for( size_t k = k0; k < k1; k++ ) {
+                if( this->contains( i, j, k, x, y, z ) )
+                    return static_cast< int >( i + this->m_nx * ( j + this->m_ny * k ) );
+            }
+        }
+
+        return -1;
+    }
+
+
+    std::vector< int > CellLocator::findCells( const std::vector< std::array< double, 3 > >& points ) const {
+        std::vector< int > cells( points.size() );
+        parallel::for_each( points.size(), [&]( size_t index ) {
+            const auto& p = points[ index ];
+            cells[ index ] = this->findCell( p[0], p[1], p[2] );
+        }, 256 );
+
+        return cells;
+    }
+}
@@ -0,0 +1,425 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+
+#include <opm/parser/eclipse/EclipseState/Grid/ConnectionGraph.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
+
+namespace Opm {
+
+namespace {
+
+    struct connection {
+        size_t neighbour;   // global index
+        int face;
+        double multiplier;
+        ConnectionGraph::Type type;
+    };
+
+    const FaceDir::DirEnum plus_dir[ 3 ] = { FaceDir::XPlus, FaceDir::YPlus, FaceDir::ZPlus };
+    const FaceDir::DirEnum minus_dir[ 3 ] = { FaceDir::XMinus, FaceDir::YMinus, FaceDir::ZMinus };
+
+    /*
+      The top corners of the cell on the minus and the plus side of a
+      face in the X and Y directions, pairwise on the same pillar; the
+      bottom corners are four higher.
+    */
+    const int minus_corners[ 2 ][ 2 ] = { { 1, 3 }, { 2, 3 } };
+    const int plus_corners[ 2 ][ 2 ] = { { 0, 2 }, { 0, 1 } };
+
+    /* Overlaps thinner than this, in meters, do not make a connection. */
+    const double overlap_tolerance = 1e-6;
+
+    /*
+      The largest vertical overlap between two cell faces along the
+      face, where a and b are the top and bottom z of the two faces at
+      the two pillars. The overlap is the smallest of four linear
+      functions along the face, and the maximum is at one of the
+      pillars or where two of the functions cross.
+    */
+    double faceOverlap( const double a_top[ 2 ], const double a_bottom[ 2 ],
+                        const double b_top[ 2 ], const double b_bottom[ 2 ] ) {
+        double f[ 4 ][ 2 ];
+        for( int p = 0; p < 2; p++ ) {
+            f[ 0 ][ p ] = a_bottom[ p ] - a_top[ p ];
+            f[ 1 ][ p ] = a_bottom[ p ] - b_top[ p ];
+            f[ 2 ][ p ] = b_bottom[ p ] - a_top[ p ];
+            f[ 3 ][ p ] = b_bottom[ p ] - b_top[ p ];
+        }
+
+        const auto overlap = [&f]( double t ) {
+            double value = f[ 0 ][ 0 ] + t * ( f[ 0 ][ 1 ] - f[ 0 ][ 0 ] );
+            for( int n = 1; n < 4; n++ )
+                value = std::min( value, f[ n ][ 0 ] + t * ( f[ n ][ 1 ] - f[ n ][ 0 ] ) );
+            return value;
+        };
+
+        double max_overlap = std::max( overlap( 0 ), overlap( 1 ) );
+        for( int n = 0; n < 4; n++ ) {
+            for( int m = n + 1; m < 4; m++ ) {
+                const double d0 = f[ n ][ 0 ] - f[ m ][ 0 ];
+                const double d1 = f[ n ][ 1 ] - f[ m ][ 1 ];
+                if( ( d0 < 0 ) == ( d1 < 0 ) || d0 == d1 )
+                    continue;
+
+                max_overlap = std::max( max_overlap, overlap( d0 / ( d0 - d1 ) ) );
+            }
+        }
+
+        return max_overlap;
+    }
+
+    /*
+      The connections of one cell: the cartesian neighbours, the
+      vertical connections over pinched out cells and, across the
+      faulted faces of a corner point grid, the cells in the
+      neighbouring column which overlap the face.
+    */
+    class Neighbours {
+    public:
+        Neighbours( const EclipseGrid& grid, const TransMult& transMult ) :
+            m_grid( grid ),
+            m_transMult( transMult ),
+            m_nx( grid.getNX() ), m_ny( grid.getNY() ), m_nz( grid.getNZ() ),
+            m_thickness( grid.getGeometry().getThickness() ),
+            m_pinch( grid.isPinchActive() ),
+            m_threshold( m_pinch ? grid.getPinchThresholdThickness() : 0 ),
+            m_multz_all( grid.getMultzOption() == PinchMode::ALL ),
+            m_zcorn_mapper( grid.zcornMapper() )
+        {
+            for( int axis = 0; axis < 3; axis++ ) {
+                m_plus_mult[ axis ] = &transMult.getMultipliers( plus_dir[ axis ] );
+                m_minus_mult[ axis ] = &transMult.getMultipliers( minus_dir[ axis ] );
+                m_region_mult[ axis ] = transMult.getRegionMultipliers( plus_dir[ axis ] );
+            }
+
+            if( grid.isCornerPoint() && !grid.circle() )
+                this->initFaults();
+        }
+
+        /* Replaces the content of out with the connections of cell g. */
+        void operator()( size_t g, std::vector< connection >& out ) const {
+            const size_t i = g % m_nx;
+            const size_t j = ( g / m_nx ) % m_ny;
+            const size_t k = g / ( m_nx * m_ny );
+            const size_t layer = m_nx * m_ny;
+
+            out.clear();
+            if( i > 0 ) this->lateral( g, i - 1, j, k, 0, false, out );
+            if( i + 1 < m_nx ) this->lateral( g, i, j, k, 0, true, out );
+            if( j > 0 ) this->lateral( g, i, j - 1, k, 1, false, out );
+            if( j + 1 < m_ny ) this->lateral( g, i, j, k, 1, true, out );
+
+            /* upwards, over inactive cells if pinched */
+            double thickness = 0;
+            for( size_t kk = k; kk > 0; kk-- ) {
+                const size_t above = g - ( k - kk + 1 ) * layer;
+                if( m_grid.cellActive( above ) ) {
+                    if( kk == k || thickness <= m_threshold )
+                        out.push_back( this->vertical( above, g, FaceDir::ZMinus ) );
+                    break;
+                }
+
+                if( !m_pinch ) break;
+                thickness += m_thickness[ above ];
+            }
+
+            /* and downwards */
+            thickness = 0;
+            for( size_t kk = k + 1; kk < m_nz; kk++ ) {
+                const size_t below = g + ( kk - k ) * layer;
+                if( m_grid.cellActive( below ) ) {
+                    if( kk == k + 1 || thickness <= m_threshold )
+                        out.push_back( this->vertical( g, below, FaceDir::ZPlus ) );
+                    break;
+                }
+
+                if( !m_pinch ) break;
+                thickness += m_thickness[ below ];
+            }
+        }
+
+    private:
+        /*
+          The faces between two columns are faulted if the ZCORN values
+          on the two sides differ in any layer; the flags are indexed
+          with the column on the minus side, with nx - 1 columns per
+          row in the X direction and ny - 1 rows in the Y direction.
+        */
+        void initFaults() {
+            m_grid.exportZCORN( m_zcorn );
+            m_faulted[ 0 ].assign( ( m_nx - 1 ) * m_ny, 0 );
+            m_faulted[ 1 ].assign( m_nx * ( m_ny - 1 ), 0 );
+
+            for( int axis = 0; axis < 2; axis++ ) {
+                const size_t row = axis == 0 ? m_nx - 1 : m_nx;
+                parallel::for_each( m_faulted[ axis ].size(), [&]( size_t column ) {
+                    const size_t i = column % row;
+                    const size_t j = column / row;
+                    const size_t ni = axis == 0 ? i + 1 : i;
+                    const size_t nj = axis == 0 ? j : j + 1;
+
+                    for( size_t k = 0; k < m_nz && !m_faulted[ axis ][ column ]; k++ ) {
+                        for( int c = 0; c < 4; c++ ) {
+                            const int bottom = ( c / 2 ) * 4;
+                            const int p = c % 2;
+                            const double za = m_zcorn[ m_zcorn_mapper.index( i, j, k, minus_corners[ axis ][ p ] + bottom ) ];
+                            const double zb = m_zcorn[ m_zcorn_mapper.index( ni, nj, k, plus_corners[ axis ][ p ] + bottom ) ];
+                            if( za != zb ) {
+                                m_faulted[ axis ][ column ] = 1;
+                                break;
+                            }
+                        }
+                    }
+                }, 256 );
+            }
+        }
+
+        double cellMultiplier( const std::vector< double >* multipliers, size_t g ) const {
+            return multipliers->empty() ? 1.0 : ( *multipliers )[ g ];
+        }
+
+        /*
+          The multiplier of the connection between the cells g1 and g2,
+          where g2 is in the positive direction of axis from g1; the
+          bulk region multipliers are only valid for the cartesian
+          neighbours.
+        */
+        double multiplier( size_t g1, size_t g2, int axis, bool neighbours ) const {
+            const double mult = this->cellMultiplier( m_plus_mult[ axis ], g1 )
+                              * this->cellMultiplier( m_minus_mult[ axis ], g2 );
+
+            if( neighbours )
+                return mult * m_region_mult[ axis ][ g1 ];
+
+            return mult * m_transMult.getRegionMultiplier( g1, g2, plus_dir[ axis ] );
+        }
+
+        /*
+          The connections of cell g = (i,j,k) in the X (axis 0) or Y
+          (axis 1) direction; (ci,cj) is the column on the minus side
+          of the face, which is the column of g if forward is true.
+        */
+        void lateral( size_t g, size_t ci, size_t cj, size_t k, int axis, bool forward,
+                      std::vector< connection >& out ) const {
+            const size_t stride = axis == 0 ? 1 : m_nx;
+            const int face = forward ? plus_dir[ axis ] : minus_dir[ axis ];
+            const size_t row = axis == 0 ? m_nx - 1 : m_nx;
+            const bool faulted = !m_faulted[ axis ].empty() && m_faulted[ axis ][ ci + cj * row ];
+
+            if( !faulted ) {
+                const size_t g1 = forward ? g : g - stride;
+                const size_t g2 = g1 + stride;
+                const size_t neighbour = forward ? g2 : g1;
+                if( m_grid.cellActive( neighbour ) )
+                    out.push_back( { neighbour, face, this->multiplier( g1, g2, axis, true ), ConnectionGraph::Type::Cartesian } );
+                return;
+            }
+
+            const size_t ni = axis == 0 ? ci + 1 : ci;
+            const size_t nj = axis == 0 ? cj : cj + 1;
+            const size_t ti = forward ? ni : ci;
+            const size_t tj = forward ? nj : cj;
+            const int ( &own_corners )[ 2 ] = forward ? minus_corners[ axis ] : plus_corners[ axis ];
+            const int ( &other_corners )[ 2 ] = forward ? plus_corners[ axis ] : minus_corners[ axis ];
+            const size_t gi = forward ? ci : ni;
+            const size_t gj = forward ? cj : nj;
+
+            double a_top[ 2 ], a_bottom[ 2 ];
+            for( int p = 0; p < 2; p++ ) {
+                a_top[ p ] = m_zcorn[ m_zcorn_mapper.index( gi, gj, k, own_corners[ p ] ) ];
+                a_bottom[ p ] = m_zcorn[ m_zcorn_mapper.index( gi, gj, k, own_corners[ p ] + 4 ) ];
+            }
+
+            for( size_t k2 = 0; k2 < m_nz; k2++ ) {
+                double b_top[ 2 ], b_bottom[ 2 ];
+                for( int p = 0; p < 2; p++ ) {
+                    b_top[ p ] = m_zcorn[ m_zcorn_mapper.index( ti, tj, k2, other_corners[ p ] ) ];
+                    b_bottom[ p ] = m_zcorn[ m_zcorn_mapper.index( ti, tj, k2, other_corners[ p ] + 4 ) ];
+                }
+
+                /* the columns are sorted, so the rest is below the face */
+                if( b_top[ 0 ] >= a_bottom[ 0 ] && b_top[ 1 ] >= a_bottom[ 1 ] )
+                    break;
+
+                const size_t neighbour = ti + tj * m_nx + k2 * m_nx * m_ny;
+                if( !m_grid.cellActive( neighbour ) )
+                    continue;
+
+                if( faceOverlap( a_top, a_bottom, b_top, b_bottom ) <= overlap_tolerance )
+                    continue;
+
+                const size_t g1 = forward ? g : neighbour;
+                const size_t g2 = forward ? neighbour : g;
+                if( k2 == k )
+                    out.push_back( { neighbour, face, this->multiplier( g1, g2, axis, true ), ConnectionGraph::Type::Cartesian } );
+                else
+                    out.push_back( { neighbour, face, this->multiplier( g1, g2, axis, false ), ConnectionGraph::Type::Fault } );
+            }
+        }
+
+        /* The connection between g1 and g2 in the same column, g2 below g1 */
+        connection vertical( size_t g1, size_t g2, FaceDir::DirEnum face ) const {
+            const size_t layer = m_nx * m_ny;
+            const size_t neighbour = face == FaceDir::ZPlus ? g2 : g1;
+
+            if( g2 - g1 == layer )
+                return { neighbour, face, this->multiplier( g1, g2, 2, true ), ConnectionGraph::Type::Cartesian };
+
+            double mult = this->multiplier( g1, g2, 2, false );
+            if( m_multz_all ) {
+                for( size_t g = g1 + layer; g < g2; g += layer )
+                    mult *= this->cellMultiplier( m_plus_mult[ 2 ], g );
+            }
+
+            return { neighbour, face, mult, ConnectionGraph::Type::Pinch };
+        }
+
+        const EclipseGrid& m_grid;
+        const TransMult& m_transMult;
+        size_t m_nx, m_ny, m_nz;
+        const std::vector< double >& m_thickness;
+        bool m_pinch;
+        double m_threshold;
+        bool m_multz_all;
+        std::array< const std::vector< double >*, 3 > m_plus_mult;
+        std::array< const std::vector< double >*, 3 > m_minus_mult;
+        std::array< std::vector< double >, 3 > m_region_mult;
+        ZcornMapper m_zcorn_mapper;
+        std::vector< double > m_zcorn;
+        std::array< std::vector< char >, 2 > m_faulted;
+    };
+
+}
+
+    ConnectionGraph::ConnectionGraph( const EclipseGrid& grid, const TransMult& transMult, const NNC& nnc ) {
+        /*
+          The active maps and the geometry are created on demand; they
+          are touched here, before the parallel passes below.
+        */
+        const auto& active_map = grid.getActiveMap();
+        const size_t active = active_map.size();
+        const Neighbours neighbours( grid, transMult );
+
+        std::vector< size_t > nnc_count( active, 0 );
+        for( const auto& entry : nnc.nncdata() ) {
+            if( !grid.cellActive( entry.cell1 ) || !grid.cellActive( entry.cell2 ) )
+                continue;
+
+            nnc_count[ grid.activeIndex( entry.cell1 ) ]++;
+            nnc_count[ grid.activeIndex( entry.cell2 ) ]++;
+        }
+
+        this->m_offsets.assign( active + 1, 0 );
+        parallel::for_ranges( active, [&]( size_t begin, size_t end ) {
+            std::vector< connection > cell_connections;
+            for( size_t a = begin; a < end; a++ ) {
+                neighbours( active_map[ a ], cell_connections );
+                this->m_offsets[ a + 1 ] = cell_connections.size() + nnc_count[ a ];
+            }
+        }, 256 );
+
+        for( size_t a = 0; a < active; a++ )
+            this->m_offsets[ a + 1 ] += this->m_offsets[ a ];
+
+        const size_t size = this->m_offsets.back();
+        this->m_neighbours.resize( size );
+        this->m_faces.resize( size );
+        this->m_multipliers.resize( size );
+        this->m_types.resize( size );
+        this->m_nnc_trans.assign( size, 0 );
+
+        /* The structured connections go first, followed by the NNCs in input order. */
+        std::vector< size_t > fill( active );
+        parallel::for_ranges( active, [&]( size_t begin, size_t end ) {
+            std::vector< connection > cell_connections;
+            for( size_t a = begin; a < end; a++ ) {
+                neighbours( active_map[ a ], cell_connections );
+
+                size_t index = this->m_offsets[ a ];
+                for( const auto& conn : cell_connections ) {
+                    this->m_neighbours[ index ] = grid.activeIndex( conn.neighbour );
+                    this->m_faces[ index ] = conn.face;
+                    this->m_multipliers[ index ] = conn.multiplier;
+                    this->m_types[ index ] = conn.type;
+                    index++;
+                }
+
+                fill[ a ] = index;
+            }
+        }, 256 );
+
+        for( const auto& entry : nnc.nncdata() ) {
+            if( !grid.cellActive( entry.cell1 ) || !grid.cellActive( entry.cell2 ) )
+                continue;
+
+            const size_t a1 = grid.activeIndex( entry.cell1 );
+            const size_t a2 = grid.activeIndex( entry.cell2 );
+            const double mult = transMult.getNNCMultiplier( entry.cell1, entry.cell2 );
+            for( const auto& pair : { std::make_pair( a1, a2 ), std::make_pair( a2, a1 ) } ) {
+                const size_t index = fill[ pair.first ]++;
+                this->m_neighbours[ index ] = pair.second;
+                this->m_faces[ index ] = 0;
+                this->m_multipliers[ index ] = mult;
+                this->m_types[ index ] = Type::NNC;
+                this->m_nnc_trans[ index ] = entry.trans;
+            }
+        }
+    }
+
+
+    size_t ConnectionGraph::numCells() const {
+        return this->m_offsets.size() - 1;
+    }
+
+    size_t ConnectionGraph::numConnections() const {
+        return this->m_neighbours.size();
+    }
+
+    const std::vector< size_t >& ConnectionGraph::offsets() const {
+        return this->m_offsets;
+    }
+
+    const std::vector< size_t >& ConnectionGraph::neighbours() const {
+        return this->m_neighbours;
+    }
+
+    const std::vector< int >& ConnectionGraph::faces() const {
+        return this->m_faces;
+    }
+
+    const std::vector< double >& ConnectionGraph::multipliers() const {
+        return this->m_multipliers;
+    }
+
+    const std::vector< ConnectionGraph::Type >& ConnectionGraph::types() const {
+        return this->m_types;
+    }
+
+    const std::vector< double >& ConnectionGraph::nncTrans() const {
+        return this->m_nnc_trans;
+    }
+}
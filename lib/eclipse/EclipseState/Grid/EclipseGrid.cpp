@@ -20,10 +20,14 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <tuple>
 #include <functional>
 
+#include <boost/filesystem.hpp>
+
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
@@ -35,6 +39,7 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/D.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/G.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/I.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/M.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/P.hpp>
@@ -43,19 +48,73 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/T.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/Z.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Grid/CartesianGeometry.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 
 #include <ert/ecl/ecl_grid.h>
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The active indices are the prefix sums of the active flags. The
+      cells are split in blocks of fixed size, which are counted in
+      parallel; the block offsets are summed serially, and the blocks
+      are then numbered in parallel. The block boundaries do not
+      depend on the number of threads, and the numbering is the same
+      as from a serial pass. A null actnum makes all cells active.
+    */
+    void initActiveIndices( const int * actnum , size_t size ,
+                            std::vector<int>& globalToActive ,
+                            std::vector<int>& activeMap ) {
+        const size_t block_size = 1 << 14;
+        const size_t blocks = ( size + block_size - 1 ) / block_size;
+        const auto active = [actnum]( size_t global_index ) {
+            return !actnum || actnum[ global_index ] > 0;
+        };
+
+        std::vector< size_t > offsets( blocks + 1 , 0 );
+        parallel::for_each( blocks , [&]( size_t block ) {
+            const size_t end = std::min( size , ( block + 1 ) * block_size );
+            size_t count = 0;
+            for (size_t global_index = block * block_size; global_index < end; global_index++)
+                count += active( global_index );
+
+            offsets[ block + 1 ] = count;
+        }, 1 );
+
+        for (size_t block = 0; block < blocks; block++)
+            offsets[ block + 1 ] += offsets[ block ];
+
+        globalToActive.resize( size );
+        activeMap.resize( offsets.back() );
+        parallel::for_each( blocks , [&]( size_t block ) {
+            const size_t end = std::min( size , ( block + 1 ) * block_size );
+            int active_index = static_cast<int>( offsets[ block ] );
+            for (size_t global_index = block * block_size; global_index < end; global_index++) {
+                if (active( global_index )) {
+                    globalToActive[ global_index ] = active_index;
+                    activeMap[ active_index++ ] = static_cast<int>( global_index );
+                } else
+                    globalToActive[ global_index ] = -1;
+            }
+        }, 1 );
+    }
+
+}
+
 
     EclipseGrid::EclipseGrid(std::array<int, 3>& dims ,
 			     const std::vector<double>& coord , 
 			     const std::vector<double>& zcorn , 
 			     const int * actnum, 
 			     const double * mapaxes) 
-	: m_minpvValue(0),
+	: GridDims(dims),
+	  m_minpvValue(0),
 	  m_minpvMode(MinpvMode::ModeEnum::Inactive),
 	  m_pinch("PINCH"),
 	  m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
@@ -78,11 +137,7 @@ namespace Opm {
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
           m_multzMode(PinchMode::ModeEnum::TOP)
     {
-        ecl_grid_type * new_ptr = ecl_grid_load_case__( filename.c_str() , false );
-        if (new_ptr)
-            m_grid.reset( new_ptr );
-        else
-            throw std::invalid_argument("Could not load grid from binary file: " + filename);
+        initBinaryGrid( filename );
 
         m_nx = ecl_grid_get_nx( c_ptr() );
         m_ny = ecl_grid_get_ny( c_ptr() );
@@ -97,9 +152,14 @@ namespace Opm {
           m_minpvMode(MinpvMode::ModeEnum::Inactive),
           m_pinch("PINCH"),
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
-          m_multzMode(PinchMode::ModeEnum::TOP),
-          m_grid( ecl_grid_alloc_rectangular(nx, ny, nz, dx, dy, dz, NULL) )
+          m_multzMode(PinchMode::ModeEnum::TOP)
     {
+        m_cartesian = std::make_shared< const CartesianGeometry >(
+            CartesianGeometry::newDVDEPTHZ( nx, ny, nz,
+                                            std::vector<double>( nx, dx ),
+                                            std::vector<double>( ny, dy ),
+                                            std::vector<double>( nz, dz ),
+                                            std::vector<double>( (nx + 1) * (ny + 1), 0.0 )));
     }
 
     EclipseGrid::EclipseGrid(const EclipseGrid& src, const double* zcorn , const std::vector<int>& actnum)
@@ -187,8 +247,55 @@ namespace Opm {
         return this->m_circle;
     }
 
+    bool EclipseGrid::isCornerPoint( ) const {
+        return !m_cartesian;
+    }
+
+    void EclipseGrid::initBinaryGrid( const std::string& filename ) {
+        ecl_grid_type * new_ptr = ecl_grid_load_case__( filename.c_str() , false );
+        if (new_ptr)
+            m_grid.reset( new_ptr );
+        else
+            throw std::invalid_argument("Could not load grid from binary file: " + filename);
+    }
+
+
+    /*
+      With the GDFILE keyword the geometry is loaded from a binary
+      GRID/EGRID file instead of from COORD and ZCORN in the deck, so
+      the large geometry arrays never pass through the text parser. A
+      relative path is relative to the directory of the data file, and
+      the .EGRID extension can be omitted. ACTNUM in the deck will
+      still override the active cells of the grid file.
+    */
+    void EclipseGrid::initBinaryGrid( const std::array<int, 3>& dims, const Deck& deck) {
+        namespace fs = boost::filesystem;
+
+        const auto& record = deck.getKeyword<ParserKeywords::GDFILE>().getRecord(0);
+        const auto& formatted = record.getItem<ParserKeywords::GDFILE::formatted>().get< std::string >(0);
+        if (formatted == "F" || formatted == "f")
+            throw std::invalid_argument("Formatted grid files are not supported by GDFILE");
+
+        fs::path path( record.getItem<ParserKeywords::GDFILE::filename>().get< std::string >(0) );
+        if (path.is_relative() && !deck.getDataFile().empty())
+            path = fs::path( deck.getDataFile() ).parent_path() / path;
+
+        if (!fs::exists( path ) && !path.has_extension())
+            path.replace_extension( ".EGRID" );
+
+        initBinaryGrid( path.string() );
+
+        if (ecl_grid_get_nx( c_ptr() ) != dims[0] ||
+            ecl_grid_get_ny( c_ptr() ) != dims[1] ||
+            ecl_grid_get_nz( c_ptr() ) != dims[2])
+            throw std::invalid_argument("The dimensions of the grid file: " + path.string() + " do not match the dimensions of the deck");
+    }
+
+
     void EclipseGrid::initGrid( const std::array<int, 3>& dims, const Deck& deck) {
-        if (deck.hasKeyword<ParserKeywords::RADIAL>()) {
+        if (deck.hasKeyword<ParserKeywords::GDFILE>()) {
+            initBinaryGrid( dims, deck );
+        } else if (deck.hasKeyword<ParserKeywords::RADIAL>()) {
             initCylindricalGrid( dims, deck );
         } else {
             if (hasCornerPointKeywords(deck)) {
@@ -238,18 +345,22 @@ namespace Opm {
     }
 
     size_t EclipseGrid::activeIndex(size_t globalIndex) const {
-        int active_index = ecl_grid_get_active_index1( m_grid.get() , globalIndex );
+        assertGlobalIndex( globalIndex );
+        int active_index = this->getGlobalToActiveMap()[ globalIndex ];
         if (active_index < 0)
             throw std::invalid_argument("Input argument does not correspond to an active cell");
         return static_cast<size_t>( active_index );
     }
 
     /**
-       Observe: the input argument is assumed to be in the space
-       [0,num_active).
+       Observe: the input argument must be in the space [0,num_active).
     */
     size_t EclipseGrid::getGlobalIndex(size_t active_index) const {
-        int global_index = ecl_grid_get_global_index1A( m_grid.get() , active_index );
+        const auto& active_map = this->getActiveMap();
+        if (active_index >= active_map.size())
+            throw std::invalid_argument("Input argument is not a valid active index");
+
+        int global_index = active_map[ active_index ];
         return static_cast<size_t>(global_index);
     }
 
@@ -304,7 +415,8 @@ namespace Opm {
         assertVectorSize( DYV    , static_cast<size_t>( dims[1] ) , "DYV");
         assertVectorSize( DZV    , static_cast<size_t>( dims[2] ) , "DZV");
 
-        m_grid.reset( ecl_grid_alloc_dxv_dyv_dzv_depthz( dims[0] , dims[1] , dims[2] , DXV.data() , DYV.data() , DZV.data() , DEPTHZ.data() , nullptr ) );
+        m_cartesian = std::make_shared< const CartesianGeometry >(
+            CartesianGeometry::newDVDEPTHZ( dims[0] , dims[1] , dims[2] , DXV , DYV , DZV , DEPTHZ ));
     }
 
 
@@ -313,7 +425,8 @@ namespace Opm {
         std::vector<double> DY = createDVector( dims , 1 , "DY" , "DYV" , deck);
         std::vector<double> DZ = createDVector( dims , 2 , "DZ" , "DZV" , deck);
         std::vector<double> TOPS = createTOPSVector( dims , DZ , deck );
-        m_grid.reset( ecl_grid_alloc_dx_dy_dz_tops( dims[0] , dims[1] , dims[2] , DX.data() , DY.data() , DZ.data() , TOPS.data() , nullptr ) );
+        m_cartesian = std::make_shared< const CartesianGeometry >(
+            CartesianGeometry::newDTOPS( dims[0] , dims[1] , dims[2] , DX , DY , DZ , TOPS ));
     }
 
 
@@ -385,7 +498,8 @@ namespace Opm {
                 for (int k = 1; k < dims[2]; k++)
                     zk[k] = zk[k - 1] + dzv[k - 1];
 
-                for (int k = 0; k < dims[2]; k++) {
+                /* The layers are independent and assembled in parallel. */
+                parallel::for_each( dims[2] , [&]( size_t k ) {
                     for (int j = 0; j < dims[1]; j++) {
                         for (int i = 0; i < dims[0]; i++) {
                             size_t tops_value = tops[ i + dims[0] * j];
@@ -395,7 +509,7 @@ namespace Opm {
                             }
                         }
                     }
-                }
+                }, 1 );
             }
             {
                 std::vector<double> ri(dims[0] + 1);
@@ -444,8 +558,18 @@ namespace Opm {
                                           const int * actnum,
                                           const double * mapaxes)
     {
-        const std::vector<float> zcorn_float( zcorn.begin() , zcorn.end() );
-        const std::vector<float> coord_float( coord.begin() , coord.end() );
+        std::vector<float> zcorn_float( zcorn.size() );
+        std::vector<float> coord_float( coord.size() );
+        {
+            const auto to_float = []( const std::vector<double>& src , std::vector<float>& target ) {
+                parallel::for_ranges( src.size() , [&]( size_t begin , size_t end ) {
+                    std::copy( src.begin() + begin , src.begin() + end , target.begin() + begin );
+                }, 1 << 16 );
+            };
+
+            to_float( zcorn , zcorn_float );
+            to_float( coord , coord_float );
+        }
         float * mapaxes_float = nullptr;
         if (mapaxes) {
             mapaxes_float = new float[6];
@@ -695,6 +819,12 @@ namespace Opm {
     }
 
     const ecl_grid_type * EclipseGrid::c_ptr() const {
+        if (m_cartesian) {
+            std::lock_guard< std::recursive_mutex > lock( m_cacheMutex );
+            if (!m_grid)
+                m_grid.reset( m_cartesian->allocGrid( m_actnum.empty() ? nullptr : m_actnum.data() ));
+        }
+
         return m_grid.get();
     }
 
@@ -719,7 +849,7 @@ namespace Opm {
 
 
     size_t EclipseGrid::getNumActive( ) const {
-        return static_cast<size_t>(ecl_grid_get_nactive( c_ptr() ));
+        return this->getActiveMap().size();
     }
 
     bool EclipseGrid::allActive( ) const {
@@ -728,39 +858,54 @@ namespace Opm {
 
     bool EclipseGrid::cellActive( size_t globalIndex ) const {
         assertGlobalIndex( globalIndex );
-        return ecl_grid_cell_active1( c_ptr() , static_cast<int>(globalIndex));
+        return this->getGlobalToActiveMap()[ globalIndex ] >= 0;
     }
 
     bool EclipseGrid::cellActive( size_t i , size_t j , size_t k ) const {
         assertIJK(i,j,k);
-        return ecl_grid_cell_active3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return this->getGlobalToActiveMap()[ getGlobalIndex(i,j,k) ] >= 0;
     }
 
 
     double EclipseGrid::getCellVolume(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (m_cartesian)
+            return GridGeometry::cellVolume( m_cartesian->getCorners( globalIndex ));
+
         return ecl_grid_get_cell_volume1( c_ptr() , static_cast<int>(globalIndex));
     }
 
 
     double EclipseGrid::getCellVolume(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
+        if (m_cartesian)
+            return GridGeometry::cellVolume( m_cartesian->getCorners( i,j,k ));
+
         return ecl_grid_get_cell_volume3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
     }
 
     double EclipseGrid::getCellThicknes(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
+        if (m_cartesian)
+            return GridGeometry::cellThickness( m_cartesian->getCorners( i,j,k ));
+
         return ecl_grid_get_cell_thickness3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
     }
 
     double EclipseGrid::getCellThicknes(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (m_cartesian)
+            return GridGeometry::cellThickness( m_cartesian->getCorners( globalIndex ));
+
         return ecl_grid_get_cell_thickness1( c_ptr() , static_cast<int>(globalIndex));
     }
 
 
     std::array<double, 3> EclipseGrid::getCellDims(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (m_cartesian)
+            return GridGeometry::cellDims( m_cartesian->getCorners( globalIndex ));
+
         {
             double dx = ecl_grid_get_cell_dx1( c_ptr() , globalIndex);
             double dy = ecl_grid_get_cell_dy1( c_ptr() , globalIndex);
@@ -772,6 +917,9 @@ namespace Opm {
 
     std::array<double, 3> EclipseGrid::getCellDims(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
+        if (m_cartesian)
+            return GridGeometry::cellDims( m_cartesian->getCorners( i,j,k ));
+
         {
             size_t globalIndex = getGlobalIndex( i,j,k );
             double dx = ecl_grid_get_cell_dx1( c_ptr() , globalIndex);
@@ -784,6 +932,9 @@ namespace Opm {
 
     std::array<double, 3> EclipseGrid::getCellCenter(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (m_cartesian)
+            return GridGeometry::cellCenter( m_cartesian->getCorners( globalIndex ));
+
         {
             double x,y,z;
             ecl_grid_get_xyz1( c_ptr() , static_cast<int>(globalIndex) , &x , &y , &z);
@@ -811,6 +962,10 @@ namespace Opm {
         assertIJK(i,j,k);
         if (corner_index >= 8)
             throw std::invalid_argument("Invalid corner position");
+
+        if (m_cartesian)
+            return m_cartesian->getCorners( i,j,k )[ corner_index ];
+
         {
             double x,y,z;
             ecl_grid_get_cell_corner_xyz3( c_ptr() ,
@@ -826,6 +981,9 @@ namespace Opm {
 
     std::array<double, 3> EclipseGrid::getCellCenter(size_t i,size_t j, size_t k) const {
         assertIJK(i,j,k);
+        if (m_cartesian)
+            return GridGeometry::cellCenter( m_cartesian->getCorners( i,j,k ));
+
         {
             double x,y,z;
             ecl_grid_get_xyz3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k), &x , &y , &z);
@@ -835,12 +993,18 @@ namespace Opm {
 
     double EclipseGrid::getCellDepth(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
+        if (m_cartesian)
+            return GridGeometry::cellCenter( m_cartesian->getCorners( globalIndex ))[2];
+
         return ecl_grid_get_cdepth1( c_ptr() , static_cast<int>(globalIndex));
     }
 
 
     double EclipseGrid::getCellDepth(size_t i,size_t j, size_t k) const {
         assertIJK(i,j,k);
+        if (m_cartesian)
+            return GridGeometry::cellCenter( m_cartesian->getCorners( i,j,k ))[2];
+
         return ecl_grid_get_cdepth3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
     }
 
@@ -850,6 +1014,8 @@ namespace Opm {
         size_t volume = getNX() * getNY() * getNZ();
         if (getNumActive() == volume)
             actnum.resize(0);
+        else if (m_cartesian)
+            actnum = m_actnum;
         else {
             actnum.resize( volume );
             ecl_grid_init_actnum_data( c_ptr() , actnum.data() );
@@ -857,7 +1023,7 @@ namespace Opm {
     }
 
     void EclipseGrid::exportMAPAXES( std::vector<double>& mapaxes) const {
-        if (ecl_grid_use_mapaxes( c_ptr())) {
+        if (!m_cartesian && ecl_grid_use_mapaxes( c_ptr())) {
             mapaxes.resize(6);
             ecl_grid_init_mapaxes_data_double( c_ptr() , mapaxes.data() );
         } else {
@@ -866,6 +1032,11 @@ namespace Opm {
     }
 
     void EclipseGrid::exportCOORD( std::vector<double>& coord) const {
+        if (m_cartesian) {
+            m_cartesian->exportCOORD( coord );
+            return;
+        }
+
         coord.resize( ecl_grid_get_coord_size( c_ptr() ));
         ecl_grid_init_coord_data_double( c_ptr() , coord.data() );
     }
@@ -873,8 +1044,12 @@ namespace Opm {
     size_t EclipseGrid::exportZCORN( std::vector<double>& zcorn) const {
         ZcornMapper mapper( getNX(), getNY(), getNZ());
 
-        zcorn.resize( ecl_grid_get_zcorn_size( c_ptr() ));
-        ecl_grid_init_zcorn_data_double( c_ptr() , zcorn.data() );
+        if (m_cartesian)
+            m_cartesian->exportZCORN( zcorn );
+        else {
+            zcorn.resize( ecl_grid_get_zcorn_size( c_ptr() ));
+            ecl_grid_init_zcorn_data_double( c_ptr() , zcorn.data() );
+        }
 
         return mapper.fixupZCORN( zcorn );
     }
@@ -882,33 +1057,118 @@ namespace Opm {
 
 
     const std::vector<int>& EclipseGrid::getActiveMap() const {
-        if( !this->activeMap.empty() ) return this->activeMap;
+        if( this->m_globalToActive.empty() )
+            this->initActiveMaps();
+
+        return this->activeMap;
+    }
+
+    const std::vector<int>& EclipseGrid::getGlobalToActiveMap() const {
+        if( this->m_globalToActive.empty() )
+            this->initActiveMaps();
 
-        this->activeMap.resize( this->getNumActive() );
-        const auto size = int(this->getCartesianSize());
+        return this->m_globalToActive;
+    }
 
-        for( int global_index = 0; global_index < size; global_index++) {
+    void EclipseGrid::initActiveMaps() const {
+        if (m_cartesian) {
+            initActiveIndices( m_actnum.empty() ? nullptr : m_actnum.data() , this->getCartesianSize() ,
+                               this->m_globalToActive , this->activeMap );
+            return;
+        }
+
+        /*
+          ERT numbers the active cells in global order, which is the
+          prefix sum of its ACTNUM. If the counts do not agree, as
+          for ACTNUM values ERT treats differently, the indices are
+          taken from ERT one cell at a time.
+        */
+        const auto * grid = this->c_ptr();
+        std::vector<int> actnum( this->getCartesianSize() );
+        ecl_grid_init_actnum_data( grid , actnum.data() );
+        initActiveIndices( actnum.data() , actnum.size() , this->m_globalToActive , this->activeMap );
+        if (this->activeMap.size() == static_cast<size_t>( ecl_grid_get_nactive( grid )))
+            return;
+
+        this->activeMap.resize( ecl_grid_get_nactive( grid ));
+        parallel::for_each( this->getCartesianSize() , [&]( size_t global_index ) {
             // Using the low level C function to get the active index, because the C++
             // version will throw for inactive cells.
-            int active_index = ecl_grid_get_active_index1( m_grid.get() , global_index );
+            int active_index = ecl_grid_get_active_index1( grid , static_cast<int>(global_index) );
+            this->m_globalToActive[ global_index ] = active_index;
             if (active_index >= 0)
-                this->activeMap[ active_index ] = global_index;
-        }
-
-        return this->activeMap;
+                this->activeMap[ active_index ] = static_cast<int>(global_index);
+        });
     }
 
     void EclipseGrid::resetACTNUM( const int * actnum) {
-        ecl_grid_reset_actnum( m_grid.get() , actnum );
-        /* re-build the active map cache */
-        this->activeMap.clear();
-        this->getActiveMap();
+        if (m_cartesian) {
+            if (actnum)
+                m_actnum.assign( actnum , actnum + this->getCartesianSize() );
+            else
+                m_actnum.clear();
+        }
+
+        if (m_grid)
+            ecl_grid_reset_actnum( m_grid.get() , actnum );
+
+        /* re-build the active map caches */
+        this->initActiveMaps();
     }
 
     ZcornMapper EclipseGrid::zcornMapper() const {
         return ZcornMapper( getNX() , getNY(), getNZ() );
     }
 
+    GridGeometry::corner_function EclipseGrid::cornerFunction() const {
+        if (m_cartesian) {
+            const auto cartesian = m_cartesian;
+            return [cartesian]( size_t i, size_t j, size_t k, GridGeometry::corners& corners ) {
+                corners = cartesian->getCorners( i,j,k );
+            };
+        }
+
+        /*
+          Observe that the raw ZCORN from the grid is used here, and
+          not exportZCORN() which will adjust overlapping cells; the
+          corners should be the same as from the per cell methods. The
+          function holds on to the arrays, and can outlive the grid.
+        */
+        const auto coord = std::make_shared< std::vector<double> >();
+        const auto zcorn = std::make_shared< std::vector<double> >( ecl_grid_get_zcorn_size( c_ptr() ));
+        this->exportCOORD( *coord );
+        ecl_grid_init_zcorn_data_double( c_ptr() , zcorn->data() );
+
+        const auto corner_point = GridGeometry::cornerPoint( getNX(), getNY(), getNZ(), *coord, *zcorn );
+        return [coord, zcorn, corner_point]( size_t i, size_t j, size_t k, GridGeometry::corners& corners ) {
+            corner_point( i,j,k, corners );
+        };
+    }
+
+    const GridGeometry& EclipseGrid::getGeometry() const {
+        std::lock_guard< std::recursive_mutex > lock( m_cacheMutex );
+        if (!this->m_geometry)
+            this->m_geometry = std::make_shared< const GridGeometry >( getNX(), getNY(), getNZ(), this->cornerFunction() );
+
+        return *this->m_geometry;
+    }
+
+    int EclipseGrid::findCell( double x, double y, double z ) const {
+        return this->getLocator().findCell( x, y, z );
+    }
+
+    std::vector< int > EclipseGrid::findCells( const std::vector< std::array< double, 3 > >& points ) const {
+        return this->getLocator().findCells( points );
+    }
+
+    const CellLocator& EclipseGrid::getLocator() const {
+        std::lock_guard< std::recursive_mutex > lock( m_cacheMutex );
+        if (!this->m_locator)
+            this->m_locator = std::make_shared< const CellLocator >( getNX(), getNY(), getNZ(), this->cornerFunction() );
+
+        return *this->m_locator;
+    }
+
     ZcornMapper::ZcornMapper(size_t nx , size_t ny, size_t nz)
         : dims( {{nx,ny,nz}} ),
           stride( {{2 , 4*nx, 8*nx*ny}} ),
@@ -976,14 +1236,25 @@ namespace Opm {
 
 
 
+    /*
+      An adjustment only propagates downwards along one corner of a
+      column of cells, i.e. the columns can be fixed up
+      independently. The columns are processed in parallel, and the
+      result is identical to a serial pass over the whole grid.
+    */
     size_t ZcornMapper::fixupZCORN( std::vector<double>& zcorn) {
         int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
-        size_t cells_adjusted = 0;
+        std::atomic<size_t> cells_adjusted( 0 );
+
+        parallel::for_ranges( this->dims[0] * this->dims[1] , [&]( size_t begin , size_t end ) {
+            size_t adjusted = 0;
 
-        for (size_t k=0; k < this->dims[2]; k++)
-            for (size_t j=0; j < this->dims[1]; j++)
-                for (size_t i=0; i < this->dims[0]; i++)
-                    for (size_t c=0; c < 4; c++) {
+            for (size_t column = begin; column < end; column++) {
+                const size_t i = column % this->dims[0];
+                const size_t j = column / this->dims[0];
+
+                for (size_t c=0; c < 4; c++)
+                    for (size_t k=0; k < this->dims[2]; k++) {
                         /* Cell to cell */
                         if (k > 0) {
                             size_t index1 = this->index(i,j,k-1,c+4);
@@ -991,7 +1262,7 @@ namespace Opm {
 
                             if ((zcorn[index2] - zcorn[index1]) * sign < 0 ) {
                                 zcorn[index2] = zcorn[index1];
-                                cells_adjusted++;
+                                adjusted++;
                             }
                         }
 
@@ -1003,10 +1274,15 @@ namespace Opm {
 
                             if ((zcorn[index2] - zcorn[index1]) * sign < 0 ) {
                                 zcorn[index2] = zcorn[index1];
-                                cells_adjusted++;
+                                adjusted++;
                             }
                         }
                     }
+            }
+
+            cells_adjusted += adjusted;
+        }, 64 );
+
         return cells_adjusted;
     }
 
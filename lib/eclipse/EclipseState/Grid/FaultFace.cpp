@@ -27,7 +27,11 @@ namespace Opm {
                          size_t J1 , size_t J2,
                          size_t K1 , size_t K2,
                          FaceDir::DirEnum faceDir)
-        : m_faceDir( faceDir )
+        : m_faceDir( faceDir ),
+          m_nx( nx ), m_ny( ny ),
+          m_I1( I1 ), m_I2( I2 ),
+          m_J1( J1 ), m_J2( J2 ),
+          m_K1( K1 ), m_K2( K2 )
     {
         checkCoord(nx , I1,I2);
         checkCoord(ny , J1,J2);
@@ -45,14 +49,6 @@ namespace Opm {
         if ((faceDir == FaceDir::ZPlus) || (faceDir == FaceDir::ZMinus))
             if (K1 != K2)
                 throw std::invalid_argument("When the face is in Z direction we must have K1 == K2");
-
-
-        for (size_t k=K1; k <= K2; k++)
-            for (size_t j=J1; j <= J2; j++)
-                for (size_t i=I1; i <= I2; i++) {
-                    size_t globalIndex = i + j*nx + k*nx*ny;
-                    m_indexList.push_back( globalIndex );
-                }
     }
 
 
@@ -65,12 +61,55 @@ namespace Opm {
     }
 
 
-    std::vector<size_t>::const_iterator FaultFace::begin() const {
-        return m_indexList.begin();
+    FaultFace::const_iterator::const_iterator( const FaultFace& face , size_t i , size_t j , size_t k ) :
+        m_face( &face ), m_i( i ), m_j( j ), m_k( k )
+    {}
+
+    size_t FaultFace::const_iterator::operator*() const {
+        return m_i + m_face->m_nx * ( m_j + m_face->m_ny * m_k );
+    }
+
+    FaultFace::const_iterator& FaultFace::const_iterator::operator++() {
+        if (m_i < m_face->m_I2) {
+            ++m_i;
+            return *this;
+        }
+
+        m_i = m_face->m_I1;
+        if (m_j < m_face->m_J2) {
+            ++m_j;
+            return *this;
+        }
+
+        m_j = m_face->m_J1;
+        ++m_k;
+        return *this;
+    }
+
+    FaultFace::const_iterator FaultFace::const_iterator::operator++(int) {
+        auto current = *this;
+        ++(*this);
+        return current;
+    }
+
+    bool FaultFace::const_iterator::operator==( const const_iterator& rhs ) const {
+        return m_face == rhs.m_face
+            && m_i == rhs.m_i
+            && m_j == rhs.m_j
+            && m_k == rhs.m_k;
+    }
+
+    bool FaultFace::const_iterator::operator!=( const const_iterator& rhs ) const {
+        return !( *this == rhs );
     }
 
-    std::vector<size_t>::const_iterator FaultFace::end() const {
-        return m_indexList.end();
+
+    FaultFace::const_iterator FaultFace::begin() const {
+        return const_iterator( *this , m_I1 , m_J1 , m_K1 );
+    }
+
+    FaultFace::const_iterator FaultFace::end() const {
+        return const_iterator( *this , m_I1 , m_J1 , m_K2 + 1 );
     }
 
 
@@ -78,12 +117,26 @@ namespace Opm {
         return m_faceDir;
     }
 
+    size_t FaultFace::size() const {
+        return (m_I2 - m_I1 + 1) * (m_J2 - m_J1 + 1) * (m_K2 - m_K1 + 1);
+    }
+
+    size_t FaultFace::getNX() const { return m_nx; }
+    size_t FaultFace::getNY() const { return m_ny; }
+    size_t FaultFace::getI1() const { return m_I1; }
+    size_t FaultFace::getI2() const { return m_I2; }
+    size_t FaultFace::getJ1() const { return m_J1; }
+    size_t FaultFace::getJ2() const { return m_J2; }
+    size_t FaultFace::getK1() const { return m_K1; }
+    size_t FaultFace::getK2() const { return m_K2; }
+
     bool FaultFace::operator==( const FaultFace& rhs ) const {
         return this->m_faceDir == rhs.m_faceDir
-            && this->m_indexList.size() == rhs.m_indexList.size()
-            && std::equal( this->m_indexList.begin(),
-                           this->m_indexList.end(),
-                           rhs.m_indexList.begin() );
+            && this->m_nx == rhs.m_nx
+            && this->m_ny == rhs.m_ny
+            && this->m_I1 == rhs.m_I1 && this->m_I2 == rhs.m_I2
+            && this->m_J1 == rhs.m_J1 && this->m_J2 == rhs.m_J2
+            && this->m_K1 == rhs.m_K1 && this->m_K2 == rhs.m_K2;
     }
 
     bool FaultFace::operator!=( const FaultFace& rhs ) const {
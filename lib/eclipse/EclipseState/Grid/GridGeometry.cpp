@@ -0,0 +1,241 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
+
+namespace Opm {
+
+namespace {
+
+    using point = std::array< double, 3 >;
+
+    /* the length of the projection of a-b on the horizontal plane */
+    double horizontalDistance( const point& a, const point& b ) {
+        const double dx = b[0] - a[0];
+        const double dy = b[1] - a[1];
+        return std::sqrt( dx * dx + dy * dy );
+    }
+
+    /* six times the signed volume of the tetrahedron a,b,c,d */
+    double tetrahedron( const point& a, const point& b, const point& c, const point& d ) {
+        const point u = {{ b[0] - a[0], b[1] - a[1], b[2] - a[2] }};
+        const point v = {{ c[0] - a[0], c[1] - a[1], c[2] - a[2] }};
+        const point w = {{ d[0] - a[0], d[1] - a[1], d[2] - a[2] }};
+
+        return u[0] * ( v[1] * w[2] - v[2] * w[1] )
+             - u[1] * ( v[0] * w[2] - v[2] * w[0] )
+             + u[2] * ( v[0] * w[1] - v[1] * w[0] );
+    }
+
+    /*
+      The corners of a cell are numbered as in EclipseGrid::getCornerPos(),
+      the upper layer (0-3) is numbered as the lower layer (4-7):
+
+         2---3
+         |   |
+         0---1
+    */
+    void cell_corners( size_t nx, size_t ny,
+                       size_t i, size_t j, size_t k,
+                       const double* coord,
+                       const double* zcorn,
+                       GridGeometry::corners& corners ) {
+
+        for( size_t c = 0; c < 8; c++ ) {
+            const size_t di = c & 1;
+            const size_t dj = ( c >> 1 ) & 1;
+            const size_t dk = ( c >> 2 ) & 1;
+
+            const double* pillar = coord + 6 * ( ( i + di ) + ( j + dj ) * ( nx + 1 ) );
+            const double z = zcorn[ ( 2 * i + di )
+                                  + ( 2 * j + dj ) * 2 * nx
+                                  + ( 2 * k + dk ) * 4 * nx * ny ];
+
+            const double x0 = pillar[0], y0 = pillar[1], z0 = pillar[2];
+            const double x1 = pillar[3], y1 = pillar[4], z1 = pillar[5];
+
+            if( z1 == z0 ) {
+                corners[ c ] = {{ x0, y0, z }};
+            } else {
+                const double t = ( z - z0 ) / ( z1 - z0 );
+                corners[ c ] = {{ x0 + t * ( x1 - x0 ), y0 + t * ( y1 - y0 ), z }};
+            }
+        }
+    }
+
+}
+
+    std::array< double, 3 > GridGeometry::cellCenter( const corners& p ) {
+        std::array< double, 3 > center = {{ 0, 0, 0 }};
+        for( const auto& corner : p ) {
+            center[0] += corner[0];
+            center[1] += corner[1];
+            center[2] += corner[2];
+        }
+
+        return {{ center[0] / 8, center[1] / 8, center[2] / 8 }};
+    }
+
+    double GridGeometry::cellVolume( const corners& p ) {
+        /*
+          As in ERT: every face is split into two triangles, which
+          together with the cell center make two tetrahedra. Both ways
+          of splitting a face are used and averaged, so the result does
+          not depend on the choice of diagonal for non-planar faces.
+          The faces are listed with the corners in cyclic order, all
+          oriented the same way.
+        */
+        static const size_t faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 },
+                                            { 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+                                            { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+
+        const auto center = cellCenter( p );
+        double volume = 0;
+        for( const auto& face : faces ) {
+            const auto& a = p[ face[0] ];
+            const auto& b = p[ face[1] ];
+            const auto& c = p[ face[2] ];
+            const auto& d = p[ face[3] ];
+
+            volume += tetrahedron( center, a, b, c ) + tetrahedron( center, a, c, d )
+                    + tetrahedron( center, a, b, d ) + tetrahedron( center, b, c, d );
+        }
+
+        return std::fabs( volume / 12 );
+    }
+
+    double GridGeometry::cellThickness( const corners& p ) {
+        double thickness = 0;
+        for( size_t c = 0; c < 4; c++ )
+            thickness += p[ c + 4 ][2] - p[ c ][2];
+
+        return std::fabs( thickness / 4 );
+    }
+
+    std::array< double, 3 > GridGeometry::cellDims( const corners& p ) {
+        /*
+          As in ERT the horizontal sizes only use the x and y components
+          of the cell edges, so a dipping cell is not made longer by its
+          dip.
+        */
+        const double dx = horizontalDistance( p[0], p[1] ) + horizontalDistance( p[2], p[3] )
+                        + horizontalDistance( p[4], p[5] ) + horizontalDistance( p[6], p[7] );
+
+        const double dy = horizontalDistance( p[0], p[2] ) + horizontalDistance( p[1], p[3] )
+                        + horizontalDistance( p[4], p[6] ) + horizontalDistance( p[5], p[7] );
+
+        return {{ dx / 4, dy / 4, cellThickness( p ) }};
+    }
+
+
+    GridGeometry::corner_function GridGeometry::cornerPoint( size_t nx, size_t ny, size_t nz,
+                                                             const std::vector< double >& coord,
+                                                             const std::vector< double >& zcorn ) {
+        if( coord.size() != 6 * ( nx + 1 ) * ( ny + 1 ) )
+            throw std::invalid_argument( "Wrong size of COORD input vector" );
+
+        if( zcorn.size() != 8 * nx * ny * nz )
+            throw std::invalid_argument( "Wrong size of ZCORN input vector" );
+
+        return [nx, ny, &coord, &zcorn]( size_t i, size_t j, size_t k, GridGeometry::corners& p ) {
+            cell_corners( nx, ny, i, j, k, coord.data(), zcorn.data(), p );
+        };
+    }
+
+
+    GridGeometry::GridGeometry( size_t nx, size_t ny, size_t nz,
+                                const std::vector< double >& coord,
+                                const std::vector< double >& zcorn ) :
+        GridGeometry( nx, ny, nz, cornerPoint( nx, ny, nz, coord, zcorn ) )
+    {}
+
+
+    GridGeometry::GridGeometry( size_t nx, size_t ny, size_t nz,
+                                const corner_function& cell_corners ) {
+
+        const size_t size = nx * ny * nz;
+
+        this->m_center_x.resize( size );
+        this->m_center_y.resize( size );
+        this->m_depth.resize( size );
+        this->m_volume.resize( size );
+        this->m_thickness.resize( size );
+        this->m_dx.resize( size );
+        this->m_dy.resize( size );
+
+        parallel::for_ranges( size, [&]( size_t begin, size_t end ) {
+            corners p;
+
+            for( size_t g = begin; g < end; g++ ) {
+                const size_t i = g % nx;
+                const size_t j = ( g / nx ) % ny;
+                const size_t k = g / ( nx * ny );
+
+                cell_corners( i, j, k, p );
+
+                const auto center = cellCenter( p );
+                const auto dims = cellDims( p );
+
+                this->m_center_x[ g ] = center[0];
+                this->m_center_y[ g ] = center[1];
+                this->m_depth[ g ] = center[2];
+                this->m_volume[ g ] = cellVolume( p );
+                this->m_dx[ g ] = dims[0];
+                this->m_dy[ g ] = dims[1];
+                this->m_thickness[ g ] = dims[2];
+            }
+        } );
+    }
+
+    size_t GridGeometry::size() const {
+        return this->m_volume.size();
+    }
+
+    const std::vector< double >& GridGeometry::getCenterX() const {
+        return this->m_center_x;
+    }
+
+    const std::vector< double >& GridGeometry::getCenterY() const {
+        return this->m_center_y;
+    }
+
+    const std::vector< double >& GridGeometry::getDepth() const {
+        return this->m_depth;
+    }
+
+    const std::vector< double >& GridGeometry::getVolume() const {
+        return this->m_volume;
+    }
+
+    const std::vector< double >& GridGeometry::getThickness() const {
+        return this->m_thickness;
+    }
+
+    const std::vector< double >& GridGeometry::getDX() const {
+        return this->m_dx;
+    }
+
+    const std::vector< double >& GridGeometry::getDY() const {
+        return this->m_dy;
+    }
+}
@@ -21,6 +21,8 @@
 
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
 namespace Opm {
@@ -202,11 +204,20 @@ namespace Opm {
     template< typename T >
     void GridProperties<T>::assertKeyword(const std::string& keyword) const {
         const std::string kw = normalize(keyword);
-        if (m_properties.count( kw ) == 0)
+        const bool created = m_properties.count( kw ) == 0;
+        if (created)
             addAutoGeneratedKeyword_(kw);
 
         GridProperty<T>& property = m_properties.at( kw );
         property.runPostProcessor( );
+
+        /*
+          Only newly created properties are compressed here; a property
+          which has been expanded with getData() stays Dense, so that
+          references to the full array remain valid.
+        */
+        if (created && m_globalToActive && kw != "ACTNUM")
+            property.compressToActive( m_globalToActive, m_numActive );
     }
 
 
@@ -283,6 +294,25 @@ namespace Opm {
 
 
 
+    template< typename T >
+    void GridProperties<T>::compressToActive( const EclipseGrid& grid ) {
+        /*
+          The post processors may read other properties, so they are
+          all run before anything is compressed.
+        */
+        for (auto& pair : m_properties)
+            pair.second.runPostProcessor( );
+
+        m_globalToActive = std::make_shared< const std::vector< int > >( grid.getGlobalToActiveMap() );
+        m_numActive = grid.getNumActive();
+
+        for (auto& pair : m_properties) {
+            if (pair.first != "ACTNUM")
+                pair.second.compressToActive( m_globalToActive, m_numActive );
+        }
+    }
+
+
     template< typename T >
     GridProperty<T>& GridProperties<T>::getOrCreateProperty(const std::string& name) {
         if (!hasKeyword(name))
@@ -291,6 +321,22 @@ namespace Opm {
         return getKeyword(name);
     }
 
+    template< typename T >
+    bool GridProperties<T>::addConstantKeyword(const std::string& name) {
+        if (hasKeyword(name))
+            return true;
+
+        if (!supportsKeyword(name))
+            return false;
+
+        const std::string kw = normalize(name);
+        if (!isFipxxx<T>(kw) && !m_supportedKeywords.at( kw ).hasDefaultValue())
+            return false;
+
+        addKeyword(kw);
+        return true;
+    }
+
     /**
        The fine print of the manual says the ADD keyword should support
        some state dependent semantics regarding endpoint scaling arrays
@@ -363,10 +409,9 @@ namespace Opm {
             double inputValue = record.getItem("VALUE").get<double>(0);
             int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
             T targetValue = convertInputValue( targetProperty , inputValue );
-            std::vector<bool> mask;
+            const auto regionIndex = regionProperty.regionIndex();
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedSet( targetValue , mask);
+            targetProperty.regionSet( targetValue , *regionIndex , regionValue );
         } else
             throw std::invalid_argument("Fatal error processing EQUALREG record - invalid/undefined keyword: " + targetArray);
     }
@@ -379,10 +424,9 @@ namespace Opm {
             double inputValue = record.getItem("SHIFT").get<double>(0);
             int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
             T shiftValue = convertInputValue( targetProperty , inputValue );
-            std::vector<bool> mask;
+            const auto regionIndex = regionProperty.regionIndex();
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedAdd( shiftValue , mask);
+            targetProperty.regionAdd( shiftValue , *regionIndex , regionValue );
         } else
             throw std::invalid_argument("Fatal error processing ADDREG record - invalid/undefined keyword: " + targetArray);
     }
@@ -395,10 +439,9 @@ namespace Opm {
             double inputValue = record.getItem("FACTOR").get<double>(0);
             int regionValue = record.getItem("REGION_NUMBER").get<int>(0);
             T factor = convertInputValue( inputValue );
-            std::vector<bool> mask;
+            const auto regionIndex = regionProperty.regionIndex();
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedMultiply( factor , mask);
+            targetProperty.regionMultiply( factor , *regionIndex , regionValue );
         } else
             throw std::invalid_argument("Fatal error processing MULTIREG record - invalid/undefined keyword: " + targetArray);
     }
@@ -416,24 +459,53 @@ namespace Opm {
 
         {
             int regionValue = record.getItem("REGION_NUMBER").get< int >(0);
-            std::vector<bool> mask;
             GridProperty<T>& targetProperty = getOrCreateProperty( targetArray );
             GridProperty<T>& srcProperty = getKeyword( srcArray );
+            const auto regionIndex = regionProperty.regionIndex();
 
-            regionProperty.initMask( regionValue , mask);
-            targetProperty.maskedCopy( srcProperty , mask );
+            targetProperty.regionCopy( srcProperty , *regionIndex , regionValue );
         }
     }
 
+    template< typename T >
+    typename GridProperty<T>::Edit GridProperties<T>::makeEdit( const std::string& operation,
+                                                                const DeckRecord& record,
+                                                                const Box& inputBox ) {
+        using Kind = typename GridProperty<T>::Edit::Kind;
+        const std::string& field = record.getItem("field").get< std::string >(0);
+        const GridProperty<T>& property = getKeyword( field );
+
+        if (operation == "EQUALS")
+            return { Kind::Set, convertInputValue( property , record.getItem("value").get< double >(0) ), inputBox };
+
+        if (operation == "ADD")
+            return { Kind::Add, convertInputValue( property , record.getItem("shift").get< double >(0) ), inputBox };
+
+        if (operation == "MULTIPLY")
+            return { Kind::Scale, convertInputValue( record.getItem("factor").get< double >(0) ), inputBox };
+
+        throw std::invalid_argument("Not an EQUALS, ADD or MULTIPLY operation: " + operation);
+    }
+
+    template< typename T >
+    void GridProperties<T>::applyEdits( const std::string& keyword,
+                                        const std::vector< typename GridProperty<T>::Edit >& edits ) {
+        getKeyword( keyword ).apply( edits );
+    }
+
     namespace {
         /*
           The functions in this namespace are those listed as
-          available operations in the OPERATE keyword.
+          available operations in the OPERATE keyword. They are
+          function objects, so that the loop in operate() is
+          instantiated - and inlined - for every operation.
         */
 
-        double MULTA(double, double X, double alpha, double beta) {
-            return alpha*X + beta;
-        }
+        struct MULTA {
+            double operator()(double, double X, double alpha, double beta) const {
+                return alpha*X + beta;
+            }
+        };
 
         // NB: The POLY function and the MULTIPLY function both use
         // the R value in the calculation. That implies that we should
@@ -441,78 +513,121 @@ namespace Opm {
         // initialized with a valid value, For all the other
         // operations R only appears on the left side of the equation,
         // and can be fully assigned to.
-        double POLY(double R, double X, double alpha, double beta) {
-            return R + alpha * std::pow(X , beta );
-        }
+        struct POLY {
+            double operator()(double R, double X, double alpha, double beta) const {
+                return R + alpha * std::pow(X , beta );
+            }
+        };
 
-        double MULTIPLY(double R, double X, double , double ) {
-            return R * X;
-        }
+        struct MULTIPLY {
+            double operator()(double R, double X, double , double ) const {
+                return R * X;
+            }
+        };
 
-        double SLOG(double, double X, double alpha, double beta) {
-            return pow(10 , alpha + beta * X);
-        }
+        struct SLOG {
+            double operator()(double, double X, double alpha, double beta) const {
+                return std::pow(10 , alpha + beta * X);
+            }
+        };
 
-        double LOG10(double, double X, double , double ) {
-            return log10(X);
-        }
+        struct LOG10 {
+            double operator()(double, double X, double , double ) const {
+                return std::log10(X);
+            }
+        };
 
-        double LOGE(double, double X, double , double ) {
-            return log(X);
-        }
+        struct LOGE {
+            double operator()(double, double X, double , double ) const {
+                return std::log(X);
+            }
+        };
 
-        double INV(double, double X, double , double ) {
-            return 1.0/X;
-        }
+        struct INV {
+            double operator()(double, double X, double , double ) const {
+                return 1.0/X;
+            }
+        };
 
-        double MULTX(double, double X, double alpha, double ) {
-            return alpha * X;
-        }
+        struct MULTX {
+            double operator()(double, double X, double alpha, double ) const {
+                return alpha * X;
+            }
+        };
 
-        double ADDX(double, double X, double alpha, double ) {
-            return alpha + X;
-        }
+        struct ADDX {
+            double operator()(double, double X, double alpha, double ) const {
+                return alpha + X;
+            }
+        };
 
-        double COPY(double, double X, double, double ) {
-            return X;
-        }
+        struct COPY {
+            double operator()(double, double X, double, double ) const {
+                return X;
+            }
+        };
 
-        double MAXLIM(double, double X, double alpha, double ) {
-            return std::min( alpha , X );
-        }
+        struct MAXLIM {
+            double operator()(double, double X, double alpha, double ) const {
+                return std::min( alpha , X );
+            }
+        };
 
-        double MINLIM(double, double X, double alpha, double ) {
-            return std::max( alpha , X );
-        }
+        struct MINLIM {
+            double operator()(double, double X, double alpha, double ) const {
+                return std::max( alpha , X );
+            }
+        };
 
-        double MULTP(double, double X, double alpha, double beta) {
-            return alpha * pow(X, beta );
+        struct MULTP {
+            double operator()(double, double X, double alpha, double beta) const {
+                return alpha * std::pow(X, beta );
+            }
+        };
+
+        struct ABS {
+            double operator()(double, double X, double, double) const {
+                return std::abs(X);
+            }
+        };
+
+        /*
+          Applies the operation to the contiguous cells [0,size) of
+          target and src; target and src may be the same array.
+        */
+        template< typename F, typename T >
+        void operate( T* target, const T* src, size_t size, double alpha, double beta ) {
+            const F func{};
+            for (size_t i = 0; i < size; i++)
+                target[i] = func( target[i] , src[i] , alpha, beta );
         }
 
-        double ABS(double, double X, double, double) {
-            return std::abs(X);
+        template< typename T >
+        using operate_fptr = void (*)( T*, const T*, size_t, double, double );
+
+        template< typename T >
+        const std::map< std::string , operate_fptr< T > >& operations() {
+            static const std::map< std::string , operate_fptr< T > > operations = {{"MULTA"  , &operate< MULTA, T >},
+                                                                                   {"POLY"   , &operate< POLY, T >},
+                                                                                   {"SLOG"   , &operate< SLOG, T >},
+                                                                                   {"LOG10"  , &operate< LOG10, T >},
+                                                                                   {"LOGE"   , &operate< LOGE, T >},
+                                                                                   {"INV"    , &operate< INV, T >},
+                                                                                   {"MULTX"  , &operate< MULTX, T >},
+                                                                                   {"ADDX"   , &operate< ADDX, T >},
+                                                                                   {"COPY"   , &operate< COPY, T >},
+                                                                                   {"MAXLIM" , &operate< MAXLIM, T >},
+                                                                                   {"MINLIM" , &operate< MINLIM, T >},
+                                                                                   {"MULTP"  , &operate< MULTP, T >},
+                                                                                   {"ABS"    , &operate< ABS, T >},
+                                                                                   {"MULTIPLY" , &operate< MULTIPLY, T >}};
+            return operations;
         }
     }
 
 
     template <typename T>
     void GridProperties<T>::handleOPERATERecord( const DeckRecord& record, BoxManager& boxManager) {
-        using  operate_fptr = decltype( &MULTA );
-        static const std::map<std::string , operate_fptr> operations = {{"MULTA"  , &MULTA},
-                                                                        {"POLY"   , &POLY},
-                                                                        {"SLOG"   , &SLOG},
-                                                                        {"LOG10"  , &LOG10},
-                                                                        {"LOGE"   , &LOGE},
-                                                                        {"INV"    , &INV},
-                                                                        {"MULTX"  , &MULTX},
-                                                                        {"ADDX"   , &ADDX},
-                                                                        {"COPY"   , &COPY},
-                                                                        {"MAXLIM" , &MAXLIM},
-                                                                        {"MINLIM" , &MINLIM},
-                                                                        {"MULTP"  , &MULTP},
-                                                                        {"ABS"    , &ABS},
-                                                                        {"MULTIPLY" , &MULTIPLY}};
-
         const std::string& srcArray    = record.getItem("ARRAY").get< std::string >(0);
         const std::string& targetArray = record.getItem("TARGET_ARRAY").get< std::string >(0);
         const std::string& operation   = record.getItem("OPERATION").get< std::string >(0);
@@ -528,11 +643,20 @@ namespace Opm {
         {
             const std::vector<T>& srcData = getKeyword( srcArray ).getData();
             std::vector<T>& targetData = getOrCreateProperty( targetArray ).getData();
-            operate_fptr func = operations.at( operation );
+            operate_fptr< T > func = operations< T >().at( operation );
 
+            /*
+              The box is processed as contiguous ranges of cells, and
+              long ranges are split over the threads.
+            */
             setKeywordBox(record, boxManager);
-            for (auto index : boxManager.getActiveBox())
-                targetData[index] = func( targetData[index] , srcData[index] , alpha, beta );
+            boxManager.getActiveBox().forEachRange( [&]( size_t begin, size_t end ) {
+                    parallel::for_ranges( end - begin, [&]( size_t first, size_t last ) {
+                            func( targetData.data() + begin + first,
+                                  srcData.data() + begin + first,
+                                  last - first, alpha, beta );
+                        } );
+                } );
         }
     }
 
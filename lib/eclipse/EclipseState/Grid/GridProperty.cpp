@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <stdexcept>
@@ -27,9 +29,12 @@
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/RtempvdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 
 namespace Opm {
 
@@ -38,11 +43,51 @@ namespace Opm {
         return [=]( size_t size ) { return std::vector< T >( size, val ); };
     }
 
+    /*
+      The value of region in values, see GridPropertyLookup; regions
+      without a value get the fallback value.
+    */
+    template< typename T >
+    static T regionValue( const std::vector< T >& values, int region, T fallback ) {
+        if (region < 1 || size_t( region ) > values.size())
+            return fallback;
+
+        return values[region - 1];
+    }
+
+    template< typename T >
+    static std::function< std::vector< T >( size_t ) > expand( std::function< GridPropertyLookup< T >( size_t ) > lookup ) {
+        return [=]( size_t size ) {
+            auto table = lookup( size );
+            if (!table.regions)
+                return table.values;
+
+            std::vector< T > values( size, T() );
+            table.regions->forEachRange( [&]( size_t begin, size_t end, int region ) {
+                    std::fill( values.begin() + begin, values.begin() + end,
+                               regionValue( table.values, region, T() ));
+                } );
+            return values;
+        };
+    }
+
     template< typename T >
     static std::function< void( std::vector< T >& ) > noop() {
         return []( std::vector< T >& ) { return; };
     }
 
+    /*
+      Equality which also considers two NaN values to be the same; used
+      when merging cells into ranges of equal value.
+    */
+    static bool sameValue( int a, int b ) {
+        return a == b;
+    }
+
+    static bool sameValue( double a, double b ) {
+        return a == b || ( std::isnan( a ) && std::isnan( b ) );
+    }
+
     template< typename T >
     GridPropertySupportedKeywordInfo< T >::GridPropertySupportedKeywordInfo(
             const std::string& name,
@@ -52,7 +97,8 @@ namespace Opm {
         m_keywordName( name ),
         m_initializer( init ),
         m_postProcessor( post ),
-        m_dimensionString( dimString )
+        m_dimensionString( dimString ),
+        m_hasPostProcessor( true )
     {}
 
     template< typename T >
@@ -66,6 +112,19 @@ namespace Opm {
         m_dimensionString( dimString )
     {}
 
+    template< typename T >
+    GridPropertySupportedKeywordInfo< T >::GridPropertySupportedKeywordInfo(
+            const std::string& name,
+            std::function< GridPropertyLookup< T >( size_t ) > lookup,
+            const std::string& dimString ) :
+        m_keywordName( name ),
+        m_initializer( expand( lookup ) ),
+        m_lookup( lookup ),
+        m_postProcessor( noop< T >() ),
+        m_dimensionString( dimString ),
+        m_hasLookup( true )
+    {}
+
     template< typename T >
     GridPropertySupportedKeywordInfo< T >::GridPropertySupportedKeywordInfo(
             const std::string& name,
@@ -74,7 +133,9 @@ namespace Opm {
         m_keywordName( name ),
         m_initializer( constant( defaultValue ) ),
         m_postProcessor( noop< T >() ),
-        m_dimensionString( dimString )
+        m_dimensionString( dimString ),
+        m_defaultValue( defaultValue ),
+        m_hasDefaultValue( true )
     {}
 
     template< typename T >
@@ -86,7 +147,10 @@ namespace Opm {
         m_keywordName( name ),
         m_initializer( constant( defaultValue ) ),
         m_postProcessor( post ),
-        m_dimensionString( dimString )
+        m_dimensionString( dimString ),
+        m_defaultValue( defaultValue ),
+        m_hasDefaultValue( true ),
+        m_hasPostProcessor( true )
     {}
 
     template< typename T >
@@ -104,24 +168,74 @@ namespace Opm {
         return this->m_initializer;
     }
 
+    template< typename T >
+    const std::function< GridPropertyLookup< T >( size_t ) >& GridPropertySupportedKeywordInfo< T >::lookupInitializer() const {
+        return this->m_lookup;
+    }
+
     template< typename T >
     const std::function< void( std::vector< T >& ) >& GridPropertySupportedKeywordInfo< T >::postProcessor() const {
         return this->m_postProcessor;
     }
 
+    template< typename T >
+    bool GridPropertySupportedKeywordInfo< T >::hasDefaultValue() const {
+        return this->m_hasDefaultValue;
+    }
+
+    template< typename T >
+    T GridPropertySupportedKeywordInfo< T >::getDefaultValue() const {
+        return this->m_defaultValue;
+    }
+
+    template< typename T >
+    bool GridPropertySupportedKeywordInfo< T >::hasPostProcessor() const {
+        return this->m_hasPostProcessor;
+    }
+
+    template< typename T >
+    bool GridPropertySupportedKeywordInfo< T >::hasLookup() const {
+        return this->m_hasLookup;
+    }
+
+    template< typename T >
+    bool GridProperty< T >::BoxValue::contains( size_t i, size_t j, size_t k ) const {
+        return i >= i1 && i <= i2
+            && j >= j1 && j <= j2
+            && k >= k1 && k <= k2;
+    }
+
+    template< typename T >
+    bool GridProperty< T >::BoxValue::intersects( const BoxValue& other ) const {
+        return i1 <= other.i2 && other.i1 <= i2
+            && j1 <= other.j2 && other.j1 <= j2
+            && k1 <= other.k2 && other.k1 <= k2;
+    }
+
     template< typename T >
     GridProperty< T >::GridProperty( size_t nx, size_t ny, size_t nz, const SupportedKeywordInfo& kwInfo ) :
         m_nx( nx ),
         m_ny( ny ),
         m_nz( nz ),
         m_kwInfo( kwInfo ),
-        m_data( kwInfo.initializer()( nx * ny * nz ) ),
+        m_storage( Storage::Constant ),
+        m_value( kwInfo.hasDefaultValue() ? kwInfo.getDefaultValue() : T() ),
         m_hasRunPostProcessor( false )
-    {}
+    {
+        if (kwInfo.hasLookup()) {
+            auto table = kwInfo.lookupInitializer()( nx * ny * nz );
+            m_data.swap( table.values );
+            m_lookupIndex = table.regions;
+            m_storage = m_lookupIndex ? Storage::Lookup : Storage::Dense;
+        } else if (!kwInfo.hasDefaultValue()) {
+            m_data = kwInfo.initializer()( nx * ny * nz );
+            m_storage = Storage::Dense;
+        }
+    }
 
     template< typename T >
     size_t GridProperty< T >::getCartesianSize() const {
-        return m_data.size();
+        return m_nx * m_ny * m_nz;
     }
 
     template< typename T >
@@ -141,7 +255,32 @@ namespace Opm {
 
     template< typename T >
     T GridProperty< T >::iget( size_t index ) const {
-        return this->m_data.at( index );
+        if (index >= getCartesianSize())
+            throw std::out_of_range("Index " + std::to_string( index ) + " out of range for property " + getKeywordName());
+
+        if (m_storage == Storage::Dense)
+            return m_data[index];
+
+        if (m_storage == Storage::Compressed) {
+            const int active_index = (*m_globalToActive)[index];
+            return active_index < 0 ? m_value : m_data[active_index];
+        }
+
+        if (m_storage == Storage::Lookup)
+            return regionValue( m_data, m_lookupIndex->region( index ), m_value );
+
+        if (m_storage == Storage::Boxes) {
+            const size_t i = index % m_nx;
+            const size_t j = (index / m_nx) % m_ny;
+            const size_t k = index / (m_nx * m_ny);
+
+            for (auto box = m_boxes.rbegin(); box != m_boxes.rend(); ++box) {
+                if (box->contains( i, j, k ))
+                    return box->value;
+            }
+        }
+
+        return m_value;
     }
 
     template< typename T >
@@ -152,7 +291,20 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::iset(size_t index, T value) {
-        this->m_data.at( index ) = value;
+        m_regionIndex.reset();
+        if (m_storage == Storage::Constant || m_storage == Storage::Boxes || m_storage == Storage::Lookup) {
+            if (iget( index ) == value)
+                return;
+
+            materialize();
+        }
+
+        if (index >= getCartesianSize())
+            throw std::out_of_range("Index " + std::to_string( index ) + " out of range for property " + getKeywordName());
+
+        T* cell = cellPointer( index );
+        if (cell)
+            *cell = value;
     }
 
     template< typename T >
@@ -163,79 +315,362 @@ namespace Opm {
 
     template< typename T >
     const std::vector< T >& GridProperty< T >::getData() const {
+        materialize();
         return m_data;
     }
 
 
     template< typename T >
     std::vector< T >& GridProperty< T >::getData() {
+        m_regionIndex.reset();
+        materialize();
         return m_data;
     }
 
+    template< typename T >
+    typename GridProperty< T >::Storage GridProperty< T >::getStorage() const {
+        return m_storage;
+    }
+
+    template< typename T >
+    void GridProperty< T >::materialize() const {
+        if (m_storage == Storage::Dense)
+            return;
+
+        std::vector< T > data( getCartesianSize(), m_value );
+        if (m_storage == Storage::Compressed) {
+            const auto& global_to_active = *m_globalToActive;
+            for (size_t g = 0; g < data.size(); g++) {
+                if (global_to_active[g] >= 0)
+                    data[g] = m_data[ global_to_active[g] ];
+            }
+            m_globalToActive.reset();
+        }
+
+        if (m_storage == Storage::Lookup) {
+            m_lookupIndex->forEachRange( [&]( size_t begin, size_t end, int region ) {
+                    std::fill( data.begin() + begin, data.begin() + end,
+                               regionValue( m_data, region, m_value ));
+                } );
+            m_lookupIndex.reset();
+        }
+
+        for (const auto& box : m_boxes) {
+            for (size_t k = box.k1; k <= box.k2; k++) {
+                for (size_t j = box.j1; j <= box.j2; j++) {
+                    const auto row = data.begin() + j * m_nx + k * m_nx * m_ny;
+                    std::fill( row + box.i1, row + box.i2 + 1, box.value );
+                }
+            }
+        }
+
+        m_data.swap( data );
+        std::vector< BoxValue >().swap( m_boxes );
+        m_storage = Storage::Dense;
+    }
+
+    /*
+      Prepares for writing individual cells: Constant, Boxes and Lookup
+      storage is made Dense, whereas Compressed storage is kept.
+    */
+    template< typename T >
+    void GridProperty< T >::makeWritable() {
+        if (m_storage == Storage::Constant || m_storage == Storage::Boxes || m_storage == Storage::Lookup)
+            materialize();
+    }
+
+    /*
+      The storage for the cell with global index index, or nullptr for
+      an inactive cell in Compressed storage; only valid after
+      makeWritable().
+    */
+    template< typename T >
+    T* GridProperty< T >::cellPointer( size_t index ) {
+        if (m_storage == Storage::Dense)
+            return &m_data[index];
+
+        const int active_index = (*m_globalToActive)[index];
+        return active_index < 0 ? nullptr : &m_data[active_index];
+    }
+
+    /*
+      Will call f( cell, index ) for the cells in the box, visiting the
+      contiguous ranges of the box; for Dense storage the ranges are
+      traversed directly in the array.
+    */
+    template< typename T >
+    template< typename F >
+    void GridProperty< T >::updateCells( const Box& inputBox, F f ) {
+        makeWritable();
+        if (m_storage == Storage::Dense) {
+            /*
+              The cells are independent, so long ranges are split over
+              the threads; small boxes are processed directly.
+            */
+            T* data = m_data.data();
+            inputBox.forEachRange( [&]( size_t begin, size_t end ) {
+                    parallel::for_ranges( end - begin, [&]( size_t first, size_t last ) {
+                            for (size_t g = begin + first; g < begin + last; g++)
+                                f( data[g], g );
+                        } );
+                } );
+            return;
+        }
+
+        inputBox.forEachRange( [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++) {
+                    T* cell = cellPointer( g );
+                    if (cell)
+                        f( *cell, g );
+                }
+            } );
+    }
+
+    template< typename T >
+    template< typename F >
+    void GridProperty< T >::updateRegion( const RegionIndex& index, int region, F f ) {
+        m_regionIndex.reset();
+        makeWritable();
+        index.forEachRange( region, [&]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++) {
+                    T* cell = cellPointer( g );
+                    if (cell)
+                        f( *cell, g );
+                }
+            } );
+    }
+
+    template< typename T >
+    void GridProperty< T >::compressToActive( std::shared_ptr< const std::vector< int > > globalToActive,
+                                              size_t numActive ) {
+        m_regionIndex.reset();
+        if (globalToActive->size() != getCartesianSize())
+            throw std::invalid_argument("Size mismatch between active map and property " + getKeywordName());
+
+        if (m_storage == Storage::Constant || m_storage == Storage::Compressed || m_storage == Storage::Lookup)
+            return;
+
+        materialize();
+
+        std::vector< T > data( numActive );
+        const auto& global_to_active = *globalToActive;
+        for (size_t g = 0; g < m_data.size(); g++) {
+            if (global_to_active[g] >= 0)
+                data[ global_to_active[g] ] = m_data[g];
+        }
+
+        m_data.swap( data );
+        m_value = m_kwInfo.hasDefaultValue() ? m_kwInfo.getDefaultValue() : T();
+        m_globalToActive = globalToActive;
+        m_storage = Storage::Compressed;
+    }
+
+    template< typename T >
+    typename GridProperty< T >::BoxValue GridProperty< T >::makeBox( const Box& inputBox, T value ) const {
+        BoxValue box;
+        box.i1 = inputBox.getOffset( 0 );
+        box.j1 = inputBox.getOffset( 1 );
+        box.k1 = inputBox.getOffset( 2 );
+        box.i2 = box.i1 + inputBox.getDim( 0 ) - 1;
+        box.j2 = box.j1 + inputBox.getDim( 1 ) - 1;
+        box.k2 = box.k1 + inputBox.getDim( 2 ) - 1;
+        box.value = value;
+        return box;
+    }
+
+    /*
+      Will check if all the cells in the box have the same value without
+      looking at the individual cells; this is only possible for
+      Constant and Boxes storage.
+    */
+    template< typename T >
+    bool GridProperty< T >::uniformValue( const Box& inputBox, T& value ) const {
+        if (m_storage != Storage::Constant && m_storage != Storage::Boxes)
+            return false;
+
+        const auto input = makeBox( inputBox, m_value );
+        for (auto box = m_boxes.rbegin(); box != m_boxes.rend(); ++box) {
+            if (!box->intersects( input ))
+                continue;
+
+            if (!( box->contains( input.i1, input.j1, input.k1 ) &&
+                   box->contains( input.i2, input.j2, input.k2 )))
+                return false;
+
+            value = box->value;
+            return true;
+        }
+
+        value = m_value;
+        return true;
+    }
+
+    template< typename T >
+    void GridProperty< T >::forEachRange( const std::function< void( size_t, size_t, T ) >& f ) const {
+        const size_t size = getCartesianSize();
+        if (size == 0)
+            return;
+
+        if (m_storage == Storage::Constant) {
+            f( 0, size, m_value );
+            return;
+        }
+
+        size_t begin = 0;
+        T current = iget( 0 );
+        auto append = [&]( size_t index, T value ) {
+            if (sameValue( value, current ))
+                return;
+
+            f( begin, index, current );
+            begin = index;
+            current = value;
+        };
+
+        if (m_storage == Storage::Dense) {
+            for (size_t g = 1; g < size; g++)
+                append( g, m_data[g] );
+        } else if (m_storage == Storage::Compressed) {
+            const auto& global_to_active = *m_globalToActive;
+            for (size_t g = 1; g < size; g++) {
+                const int active_index = global_to_active[g];
+                append( g, active_index < 0 ? m_value : m_data[active_index] );
+            }
+        } else if (m_storage == Storage::Lookup) {
+            m_lookupIndex->forEachRange( [&]( size_t rangeBegin, size_t, int region ) {
+                    append( rangeBegin, regionValue( m_data, region, m_value ));
+                } );
+        } else {
+            /* The boxes are painted onto one I-row at a time. */
+            std::vector< T > row( m_nx );
+            for (size_t k = 0; k < m_nz; k++) {
+                for (size_t j = 0; j < m_ny; j++) {
+                    std::fill( row.begin(), row.end(), m_value );
+                    for (const auto& box : m_boxes) {
+                        if (box.contains( box.i1, j, k ))
+                            std::fill( row.begin() + box.i1, row.begin() + box.i2 + 1, box.value );
+                    }
+
+                    const size_t offset = j * m_nx + k * m_nx * m_ny;
+                    for (size_t i = 0; i < m_nx; i++)
+                        append( offset + i, row[i] );
+                }
+            }
+        }
+
+        f( begin, size, current );
+    }
+
     template< typename T >
     void GridProperty< T >::multiplyWith( const GridProperty< T >& other ) {
+        m_regionIndex.reset();
         if ((m_nx == other.m_nx) && (m_ny == other.m_ny) && (m_nz == other.m_nz)) {
-            for (size_t g=0; g < m_data.size(); g++)
-                m_data[g] *= other.m_data[g];
+            if (other.m_storage == Storage::Constant) {
+                m_value *= other.m_value;
+                for (auto& box : m_boxes)
+                    box.value *= other.m_value;
+
+                for (size_t g=0; g < m_data.size(); g++)
+                    m_data[g] *= other.m_value;
+            } else {
+                makeWritable();
+                for (size_t g=0; g < getCartesianSize(); g++) {
+                    T* cell = cellPointer( g );
+                    if (cell)
+                        *cell *= other.iget( g );
+                }
+            }
         } else
             throw std::invalid_argument("Size mismatch between properties in mulitplyWith.");
     }
 
     template< typename T >
     void GridProperty< T >::multiplyValueAtIndex(size_t index, T factor) {
-        m_data[index] *= factor;
+        iset( index, iget( index ) * factor );
     }
 
 
 
     template< typename T >
     void GridProperty< T >::maskedSet( T value, const std::vector< bool >& mask ) {
+        m_regionIndex.reset();
+        makeWritable();
         for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] = value;
+            T* cell = cellPointer( g );
+            if (mask[g] && cell)
+                *cell = value;
         }
     }
 
     template< typename T >
     void GridProperty< T >::maskedMultiply( T value, const std::vector<bool>& mask ) {
+        m_regionIndex.reset();
+        makeWritable();
         for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] *= value;
+            T* cell = cellPointer( g );
+            if (mask[g] && cell)
+                *cell *= value;
         }
     }
 
 
     template< typename T >
     void GridProperty< T >::maskedAdd( T value, const std::vector<bool>& mask ) {
+        m_regionIndex.reset();
+        makeWritable();
         for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] += value;
+            T* cell = cellPointer( g );
+            if (mask[g] && cell)
+                *cell += value;
         }
     }
 
     template< typename T >
     void GridProperty< T >::maskedCopy( const GridProperty< T >& other, const std::vector< bool >& mask) {
+        m_regionIndex.reset();
+        makeWritable();
         for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (mask[g])
-                m_data[g] = other.m_data[g];
+            T* cell = cellPointer( g );
+            if (mask[g] && cell)
+                *cell = other.iget( g );
         }
     }
 
+    template< typename T >
+    void GridProperty< T >::regionSet( T value, const RegionIndex& index, int region ) {
+        updateRegion( index, region, [value]( T& cell, size_t ) { cell = value; } );
+    }
+
+    template< typename T >
+    void GridProperty< T >::regionMultiply( T value, const RegionIndex& index, int region ) {
+        updateRegion( index, region, [value]( T& cell, size_t ) { cell *= value; } );
+    }
+
+    template< typename T >
+    void GridProperty< T >::regionAdd( T value, const RegionIndex& index, int region ) {
+        updateRegion( index, region, [value]( T& cell, size_t ) { cell += value; } );
+    }
+
+    template< typename T >
+    void GridProperty< T >::regionCopy( const GridProperty< T >& other, const RegionIndex& index, int region ) {
+        updateRegion( index, region, [&other]( T& cell, size_t g ) { cell = other.iget( g ); } );
+    }
+
     template< typename T >
     void GridProperty< T >::initMask( T value, std::vector< bool >& mask ) const {
-        mask.resize(getCartesianSize());
-        for (size_t g = 0; g < getCartesianSize(); g++) {
-            if (m_data[g] == value)
-                mask[g] = true;
-            else
-                mask[g] = false;
-        }
+        mask.assign( getCartesianSize(), false );
+        forEachRange( [&]( size_t begin, size_t end, T rangeValue ) {
+                if (rangeValue == value)
+                    std::fill( mask.begin() + begin, mask.begin() + end, true );
+            } );
     }
 
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const DeckKeyword& deckKeyword ) {
+        m_regionIndex.reset();
         const auto& deckItem = getDeckItem(deckKeyword);
         const auto size = deckItem.size();
+        makeWritable();
         for (size_t dataPointIdx = 0; dataPointIdx < size; ++dataPointIdx) {
             if (!deckItem.defaultApplied(dataPointIdx))
                 setDataPoint(dataPointIdx, dataPointIdx, deckItem);
@@ -244,22 +679,22 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::loadFromDeckKeyword( const Box& inputBox, const DeckKeyword& deckKeyword) {
+        m_regionIndex.reset();
         if (inputBox.isGlobal())
             loadFromDeckKeyword( deckKeyword );
         else {
             const auto& deckItem = getDeckItem(deckKeyword);
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            if (indexList.size() == deckItem.size()) {
-                for (size_t sourceIdx = 0; sourceIdx < indexList.size(); sourceIdx++) {
-                    size_t targetIdx = indexList[sourceIdx];
-                    if (sourceIdx < deckItem.size()
-                        && !deckItem.defaultApplied(sourceIdx))
-                        {
-                            setDataPoint(sourceIdx, targetIdx, deckItem);
-                        }
+            if (inputBox.size() == deckItem.size()) {
+                makeWritable();
+                size_t sourceIdx = 0;
+                for (size_t targetIdx : inputBox) {
+                    if (!deckItem.defaultApplied(sourceIdx))
+                        setDataPoint(sourceIdx, targetIdx, deckItem);
+
+                    sourceIdx++;
                 }
             } else {
-                std::string boxSize = std::to_string(static_cast<long long>(indexList.size()));
+                std::string boxSize = std::to_string(static_cast<long long>(inputBox.size()));
                 std::string keywordSize = std::to_string(static_cast<long long>(deckItem.size()));
 
                 throw std::invalid_argument("Size mismatch: Box:" + boxSize + "  DeckKeyword:" + keywordSize);
@@ -269,57 +704,193 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::copyFrom( const GridProperty< T >& src, const Box& inputBox ) {
+        m_regionIndex.reset();
+        T value = T();
+
         if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < src.getCartesianSize(); ++i)
-                m_data[i] = src.m_data[i];
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = src.m_data[targetIndex];
-            }
-        }
+            m_storage = src.m_storage;
+            m_value = src.m_value;
+            m_boxes = src.m_boxes;
+            m_data = src.m_data;
+            m_globalToActive = src.m_globalToActive;
+            m_lookupIndex = src.m_lookupIndex;
+        } else if (src.uniformValue( inputBox, value ))
+            setScalar( value, inputBox );
+        else
+            updateCells( inputBox, [&src]( T& cell, size_t index ) { cell = src.iget( index ); } );
     }
 
     template< typename T >
     void GridProperty< T >::scale( T scaleFactor, const Box& inputBox ) {
+        m_regionIndex.reset();
+        T value = T();
+
         if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] *= scaleFactor;
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] *= scaleFactor;
-            }
-        }
+            m_value *= scaleFactor;
+            for (auto& box : m_boxes)
+                box.value *= scaleFactor;
+
+            T* data = m_data.data();
+            parallel::for_ranges( m_data.size(), [=]( size_t begin, size_t end ) {
+                    for (size_t i = begin; i < end; ++i)
+                        data[i] *= scaleFactor;
+                } );
+        } else if (uniformValue( inputBox, value ))
+            setScalar( value * scaleFactor, inputBox );
+        else
+            updateCells( inputBox, [scaleFactor]( T& cell, size_t ) { cell *= scaleFactor; } );
     }
 
     template< typename T >
     void GridProperty< T >::add( T shiftValue, const Box& inputBox ) {
+        m_regionIndex.reset();
+        T value = T();
+
         if (inputBox.isGlobal()) {
-            for (size_t i = 0; i < m_data.size(); ++i)
-                m_data[i] += shiftValue;
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] += shiftValue;
-            }
-        }
+            m_value += shiftValue;
+            for (auto& box : m_boxes)
+                box.value += shiftValue;
+
+            T* data = m_data.data();
+            parallel::for_ranges( m_data.size(), [=]( size_t begin, size_t end ) {
+                    for (size_t i = begin; i < end; ++i)
+                        data[i] += shiftValue;
+                } );
+        } else if (uniformValue( inputBox, value ))
+            setScalar( value + shiftValue, inputBox );
+        else
+            updateCells( inputBox, [shiftValue]( T& cell, size_t ) { cell += shiftValue; } );
     }
 
     template< typename T >
     void GridProperty< T >::setScalar( T value, const Box& inputBox ) {
+        m_regionIndex.reset();
         if (inputBox.isGlobal()) {
-            std::fill(m_data.begin(), m_data.end(), value);
-        } else {
-            const std::vector<size_t>& indexList = inputBox.getIndexList();
-            for (size_t i = 0; i < indexList.size(); i++) {
-                size_t targetIndex = indexList[i];
-                m_data[targetIndex] = value;
+            m_storage = Storage::Constant;
+            m_value = value;
+            std::vector< BoxValue >().swap( m_boxes );
+            std::vector< T >().swap( m_data );
+            m_globalToActive.reset();
+            m_lookupIndex.reset();
+        } else if ((m_storage == Storage::Constant || m_storage == Storage::Boxes) && m_boxes.size() < maxBoxes) {
+            m_boxes.push_back( makeBox( inputBox, value ) );
+            m_storage = Storage::Boxes;
+        } else
+            updateCells( inputBox, [value]( T& cell, size_t ) { cell = value; } );
+    }
+
+    template< typename T >
+    void GridProperty< T >::apply( const std::vector< Edit >& edits ) {
+        size_t first = 0;
+        while (first < edits.size()) {
+            /*
+              A global EQUALS brings the property back to Constant
+              storage, so it ends a fused run.
+            */
+            size_t last = first;
+            if (m_storage == Storage::Dense) {
+                while (last < edits.size() && !(edits[last].kind == Edit::Kind::Set && edits[last].box.isGlobal()))
+                    last++;
+            }
+
+            if (last - first > 1) {
+                applyFused( edits.data() + first, last - first );
+                first = last;
+                continue;
             }
+
+            const auto& edit = edits[first];
+            if (edit.kind == Edit::Kind::Set)
+                setScalar( edit.value, edit.box );
+            else if (edit.kind == Edit::Kind::Add)
+                add( edit.value, edit.box );
+            else
+                scale( edit.value, edit.box );
+
+            first++;
+        }
+    }
+
+    /*
+      Applies a run of edits to Dense storage in one pass. The I-rows
+      of the bounding box are processed independently: each row is
+      split into segments at the I-boundaries of the edits covering
+      the row, and every cell of a segment only evaluates the edits
+      which contain the segment. The work is then proportional to the
+      total size of the edit boxes, also when the boxes are disjoint.
+    */
+    template< typename T >
+    void GridProperty< T >::applyFused( const Edit* edits, size_t size ) {
+        m_regionIndex.reset();
+
+        std::vector< BoxValue > boxes;
+        boxes.reserve( size );
+        for (size_t e = 0; e < size; e++)
+            boxes.push_back( makeBox( edits[e].box, edits[e].value ) );
+
+        BoxValue bounds = boxes.front();
+        for (const auto& box : boxes) {
+            bounds.j1 = std::min( bounds.j1, box.j1 );
+            bounds.k1 = std::min( bounds.k1, box.k1 );
+            bounds.j2 = std::max( bounds.j2, box.j2 );
+            bounds.k2 = std::max( bounds.k2, box.k2 );
         }
+
+        const size_t ny = bounds.j2 - bounds.j1 + 1;
+        const size_t num_rows = ny * (bounds.k2 - bounds.k1 + 1);
+        T* data = m_data.data();
+
+        parallel::for_ranges( num_rows, [&]( size_t first, size_t last ) {
+                std::vector< size_t > row_edits;
+                std::vector< size_t > cuts;
+                std::vector< size_t > segment_edits;
+
+                for (size_t row = first; row < last; row++) {
+                    const size_t j = bounds.j1 + row % ny;
+                    const size_t k = bounds.k1 + row / ny;
+
+                    row_edits.clear();
+                    cuts.clear();
+                    for (size_t e = 0; e < size; e++) {
+                        if (j < boxes[e].j1 || j > boxes[e].j2 || k < boxes[e].k1 || k > boxes[e].k2)
+                            continue;
+
+                        row_edits.push_back( e );
+                        cuts.push_back( boxes[e].i1 );
+                        cuts.push_back( boxes[e].i2 + 1 );
+                    }
+
+                    if (row_edits.empty())
+                        continue;
+
+                    std::sort( cuts.begin(), cuts.end() );
+                    cuts.erase( std::unique( cuts.begin(), cuts.end() ), cuts.end() );
+
+                    T* row_data = data + j * m_nx + k * m_nx * m_ny;
+                    for (size_t c = 0; c + 1 < cuts.size(); c++) {
+                        const size_t i1 = cuts[c];
+                        const size_t i2 = cuts[c + 1];
+
+                        segment_edits.clear();
+                        for (size_t e : row_edits) {
+                            if (boxes[e].i1 <= i1 && i1 <= boxes[e].i2)
+                                segment_edits.push_back( e );
+                        }
+
+                        for (size_t i = i1; i < i2; i++) {
+                            T& cell = row_data[i];
+                            for (size_t e : segment_edits) {
+                                if (edits[e].kind == Edit::Kind::Set)
+                                    cell = boxes[e].value;
+                                else if (edits[e].kind == Edit::Kind::Add)
+                                    cell += boxes[e].value;
+                                else
+                                    cell *= boxes[e].value;
+                            }
+                        }
+                    }
+                }
+            }, std::max< size_t >( 1, 1024 / m_nx ));
     }
 
     template< typename T >
@@ -335,18 +906,21 @@ namespace Opm {
 
     template< typename T >
     void GridProperty< T >::runPostProcessor() {
+        m_regionIndex.reset();
         if( this->m_hasRunPostProcessor ) return;
         this->m_hasRunPostProcessor = true;
+
+        if( !this->m_kwInfo.hasPostProcessor() ) return;
+        this->materialize();
         this->m_kwInfo.postProcessor()( m_data );
     }
 
     template< typename T >
     void GridProperty< T >::checkLimits( T min, T max ) const {
-        for (size_t g=0; g < m_data.size(); g++) {
-            T value = m_data[g];
-            if ((value < min) || (value > max))
-                throw std::invalid_argument("Property element " + std::to_string( value) + " in " + getKeywordName() + " outside valid limits: [" + std::to_string(min) + ", " + std::to_string(max) + "]");
-        }
+        forEachRange( [&]( size_t, size_t, T value ) {
+                if ((value < min) || (value > max))
+                    throw std::invalid_argument("Property element " + std::to_string( value) + " in " + getKeywordName() + " outside valid limits: [" + std::to_string(min) + ", " + std::to_string(max) + "]");
+            } );
     }
 
     template< typename T  >
@@ -362,22 +936,26 @@ namespace Opm {
 
         const auto& deckItem = deckKeyword.getRecord(0).getItem(0);
 
-        if (deckItem.size() > m_data.size())
+        if (deckItem.size() > getCartesianSize())
             throw std::invalid_argument("Size mismatch when setting data for:" + getKeywordName()
                                         + " keyword size: " + std::to_string( deckItem.size() )
-                                        + " input size: " + std::to_string( m_data.size()) );
+                                        + " input size: " + std::to_string( getCartesianSize()) );
 
         return deckItem;
     }
 
 template<>
 void GridProperty<int>::setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem) {
-    m_data[targetIdx] = deckItem.get< int >(sourceIdx);
+    int* cell = cellPointer( targetIdx );
+    if (cell)
+        *cell = deckItem.get< int >(sourceIdx);
 }
 
 template<>
 void GridProperty<double>::setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem) {
-    m_data[targetIdx] = deckItem.getSIDouble(sourceIdx);
+    double* cell = cellPointer( targetIdx );
+    if (cell)
+        *cell = deckItem.getSIDouble(sourceIdx);
 }
 
 template<>
@@ -388,21 +966,26 @@ bool GridProperty<int>::containsNaN( ) const {
 template<>
 bool GridProperty<double>::containsNaN( ) const {
     bool return_value = false;
-    size_t size = m_data.size();
-    size_t index = 0;
-    while (true) {
-        if (std::isnan(m_data[index])) {
-            return_value = true;
-            break;
-        }
-
-        index++;
-        if (index == size)
-            break;
-    }
+    forEachRange( [&]( size_t, size_t, double value ) {
+            if (std::isnan( value ))
+                return_value = true;
+        } );
     return return_value;
 }
 
+template<>
+std::shared_ptr< const RegionIndex > GridProperty<int>::regionIndex() const {
+    if (!m_regionIndex)
+        m_regionIndex = std::make_shared< const RegionIndex >( *this );
+
+    return m_regionIndex;
+}
+
+template<>
+std::shared_ptr< const RegionIndex > GridProperty<double>::regionIndex() const {
+    throw std::logic_error("Only <int> grid properties can be used as regions");
+}
+
 template<>
 const std::string& GridProperty<int>::getDimensionString() const {
     throw std::logic_error("Only <double> grid properties have dimension");
@@ -416,10 +999,31 @@ const std::string& GridProperty<double>::getDimensionString() const {
 
 template<typename T>
 std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
-    if (grid.allActive())
+    if (m_storage == Storage::Constant)
+        return std::vector<T>( grid.getNumActive() , m_value );
+
+    if (m_storage == Storage::Compressed && m_data.size() == grid.getNumActive())
         return m_data;
+
+    if (m_storage == Storage::Lookup) {
+        const auto& global_to_active = grid.getGlobalToActiveMap();
+        std::vector<T> compressed( grid.getNumActive() );
+        forEachRange( [&]( size_t begin, size_t end, T value ) {
+                for (size_t global_index = begin; global_index < end; global_index++) {
+                    if (global_to_active[global_index] >= 0)
+                        compressed[ global_to_active[global_index] ] = value;
+                }
+            } );
+        return compressed;
+    }
+
+    const auto& data = getData();
+    if (grid.allActive())
+        return data;
     else {
-        return grid.compressedVector( m_data );
+        std::vector<T> compressed( grid.getNumActive() );
+        grid.compress( data.data() , compressed.data() );
+        return compressed;
     }
 }
 
@@ -428,9 +1032,18 @@ std::vector<T> GridProperty<T>::compressedCopy(const EclipseGrid& grid) const {
 template<typename T>
 std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>& activeMap) const {
     std::vector<size_t> cells;
+    if (m_storage == Storage::Constant) {
+        if (m_value == value) {
+            cells.resize( activeMap.size() );
+            for (size_t active_index = 0; active_index < activeMap.size(); active_index++)
+                cells[active_index] = active_index;
+        }
+        return cells;
+    }
+
     for (size_t active_index = 0; active_index < activeMap.size(); active_index++) {
         size_t global_index = activeMap[ active_index ];
-        if (m_data[global_index] == value)
+        if (iget( global_index ) == value)
             cells.push_back( active_index );
     }
     return cells;
@@ -440,19 +1053,37 @@ std::vector<size_t> GridProperty<T>::cellsEqual(T value, const std::vector<int>&
 template<typename T>
 std::vector<size_t> GridProperty<T>::indexEqual(T value) const {
     std::vector<size_t> index_list;
-    for (size_t index = 0; index < m_data.size(); index++) {
-        if (m_data[index] == value)
-            index_list.push_back( index );
-    }
+    forEachRange( [&]( size_t begin, size_t end, T rangeValue ) {
+            if (rangeValue != value)
+                return;
+
+            for (size_t index = begin; index < end; index++)
+                index_list.push_back( index );
+        } );
     return index_list;
 }
 
 
 template<typename T>
 std::vector<size_t> GridProperty<T>::cellsEqual(T value, const EclipseGrid& grid, bool active) const {
-    if (active)
-        return cellsEqual( value , grid.getActiveMap());
-    else
+    if (active) {
+        /*
+          Scan the data in global order and translate with the dense
+          global -> active map; the active indices come out sorted.
+        */
+        const auto& global_to_active = grid.getGlobalToActiveMap();
+        std::vector<size_t> cells;
+        forEachRange( [&]( size_t begin, size_t end, T rangeValue ) {
+                if (rangeValue != value)
+                    return;
+
+                for (size_t global_index = begin; global_index < end; global_index++) {
+                    if (global_to_active[global_index] >= 0)
+                        cells.push_back( global_to_active[global_index] );
+                }
+            } );
+        return cells;
+    } else
         return indexEqual( value );
 }
 
@@ -471,12 +1102,13 @@ std::vector< double > temperature_lookup( size_t size,
 
         const auto& rtempvdTables = tables->getRtempvdTables();
         const std::vector< int >& eqlNum = ig_props->getKeyword("EQLNUM").getData();
+        const auto& depth = grid->getGeometry().getDepth();
         std::vector< double > values( size, 0 );
 
         for (size_t cellIdx = 0; cellIdx < eqlNum.size(); ++ cellIdx) {
             int cellEquilNum = eqlNum[cellIdx];
             const RtempvdTable& rtempvdTable = rtempvdTables.getTable<RtempvdTable>(cellEquilNum);
-            double cellDepth = std::get<2>(grid->getCellCenter(cellIdx));
+            double cellDepth = depth[cellIdx];
             values[cellIdx] = rtempvdTable.evaluate("Temperature", cellDepth);
         }
 
@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <stdexcept>
 #include <map>
 #include <set>
@@ -26,8 +27,10 @@
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 
 namespace Opm {
 
@@ -125,7 +128,11 @@ namespace Opm {
                                    ...}}
 
       Then it will go through the different regions and looking for
-      interface with the wanted region values.
+      interface with the wanted region values. To avoid map lookups
+      when the multipliers are evaluated for every face in the grid,
+      the search map of each region keyword is finally flattened to a
+      dense table over the region pairs which are mentioned in the
+      MULTREGT keywords.
     */
     MULTREGTScanner::MULTREGTScanner(const Eclipse3DProperties& e3DProps,
                                      const std::vector< const DeckKeyword* >& keywords) :
@@ -153,14 +160,43 @@ namespace Opm {
                               + " which is not in the deck");
         }
 
+        std::map<std::string , MULTREGTSearchMap> searchMap;
         for (auto iter = searchPairs.begin(); iter != searchPairs.end(); ++iter) {
             const MULTREGTRecord * record = (*iter).second;
             std::pair<int,int> pair = (*iter).first;
             const std::string& keyword = record->m_region.getValue();
-            if (m_searchMap.count(keyword) == 0)
-                m_searchMap[keyword] = MULTREGTSearchMap();
+            if (searchMap.count(keyword) == 0)
+                searchMap[keyword] = MULTREGTSearchMap();
 
-            m_searchMap[keyword][pair] = record;
+            searchMap[keyword][pair] = record;
+        }
+
+        for (const auto& keyword_map : searchMap) {
+            RegionTable table;
+            /*
+              The region properties are only read with iget() and
+              forEachRange(), which are safe from parallel loops and
+              leave the storage of the property as it is; getData()
+              would expand a compressed property again.
+            */
+            table.regions = &e3DProps.getIntGridProperty( keyword_map.first );
+            for (const auto& pair_record : keyword_map.second) {
+                table.values.push_back( pair_record.first.first );
+                table.values.push_back( pair_record.first.second );
+            }
+            std::sort( table.values.begin() , table.values.end() );
+            table.values.erase( std::unique( table.values.begin() , table.values.end() ) , table.values.end() );
+
+            const size_t size = table.values.size();
+            table.records.assign( size * size , -1 );
+            for (const auto& pair_record : keyword_map.second) {
+                const auto& pair = pair_record.first;
+                const size_t id1 = std::lower_bound( table.values.begin() , table.values.end() , pair.first ) - table.values.begin();
+                const size_t id2 = std::lower_bound( table.values.begin() , table.values.end() , pair.second ) - table.values.begin();
+                table.records[ id1 * size + id2 ] = pair_record.second - m_records.data();
+            }
+
+            m_tables.push_back( std::move( table ));
         }
     }
 
@@ -231,46 +267,136 @@ namespace Opm {
          -----------
 
     */
-    double MULTREGTScanner::getRegionMultiplier(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
+    const MULTREGTRecord* MULTREGTScanner::lookup(const RegionTable& table, int regionId1, int regionId2, int directions) const {
+        const auto& values = table.values;
+        const auto id1 = std::lower_bound( values.begin() , values.end() , regionId1 );
+        const auto id2 = std::lower_bound( values.begin() , values.end() , regionId2 );
+        if (id1 == values.end() || *id1 != regionId1 || id2 == values.end() || *id2 != regionId2)
+            return nullptr;
+
+        const size_t size = values.size();
+        const int index = table.records[ size_t( id1 - values.begin() ) * size + size_t( id2 - values.begin() ) ];
+        if (index < 0 || !(m_records[index].m_directions & directions))
+            return nullptr;
+
+        return &m_records[index];
+    }
 
-        for (auto iter = m_searchMap.begin(); iter != m_searchMap.end(); iter++) {
-            const Opm::GridProperty<int>& region = m_e3DProps.getIntGridProperty( (*iter).first );
-            MULTREGTSearchMap map = (*iter).second;
 
-            int regionId1 = region.iget(globalIndex1);
-            int regionId2 = region.iget(globalIndex2);
+    const MULTREGTRecord* MULTREGTScanner::applicable(const RegionTable& table, size_t globalIndex1, size_t globalIndex2,
+                                                      int regionId1, int regionId2, FaceDir::DirEnum faceDir) const {
+        const MULTREGTRecord * record = lookup( table , regionId1 , regionId2 , faceDir );
+        if (!record)
+            record = lookup( table , regionId2 , regionId1 , faceDir );
+        if (!record)
+            return nullptr;
 
+        const auto& region = *table.regions;
+        int i1 = globalIndex1 % region.getNX();
+        int i2 = globalIndex2 % region.getNX();
+        int j1 = globalIndex1 / region.getNX() % region.getNY();
+        int j2 = globalIndex2 / region.getNX() % region.getNY();
+        const bool adjacent = (std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0);
 
-            std::pair<int,int> pair{regionId1 , regionId2};
-            if (map.count(pair) != 1 || !(map.at(pair)->m_directions & faceDir)) {
-                pair = std::pair<int,int>{regionId2 , regionId1};
-                if (map.count(pair) != 1 || !(map.at(pair)->m_directions & faceDir))
-                    continue;
-            }
-            const MULTREGTRecord * record = map[pair];
-
-            bool applyMultiplier = true;
-            int i1 = globalIndex1 % region.getNX();
-            int i2 = globalIndex2 % region.getNX();
-            int j1 = globalIndex1 / region.getNX() % region.getNY();
-            int j2 = globalIndex2 / region.getNX() % region.getNY();
-
-            if (record->m_nncBehaviour == MULTREGT::NNC){
-                applyMultiplier = true;
-                if ((std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0))
-                    applyMultiplier = false;
-            }
-            else if (record->m_nncBehaviour == MULTREGT::NONNC){
-                applyMultiplier = false;
-                if ((std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0))
-                    applyMultiplier = true;
-            }
+        if (record->m_nncBehaviour == MULTREGT::NNC && adjacent)
+            return nullptr;
+
+        if (record->m_nncBehaviour == MULTREGT::NONNC && !adjacent)
+            return nullptr;
+
+        return record;
+    }
 
-            if (applyMultiplier) {
+
+    double MULTREGTScanner::getRegionMultiplier(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
+        for (const auto& table : m_tables) {
+            const auto& region = *table.regions;
+            const MULTREGTRecord * record = applicable( table , globalIndex1 , globalIndex2 ,
+                                                        region.iget( globalIndex1 ) , region.iget( globalIndex2 ) , faceDir );
+            if (record)
                 return record->m_transMultiplier;
-            }
+        }
+        return 1;
+    }
+
+
+    double MULTREGTScanner::getNNCMultiplier(size_t globalIndex1 , size_t globalIndex2) const {
+        const int allDirections = FaceDir::XPlus + FaceDir::XMinus + FaceDir::YPlus + FaceDir::YMinus + FaceDir::ZPlus + FaceDir::ZMinus;
+
+        for (const auto& table : m_tables) {
+            int regionId1 = table.regions->iget( globalIndex1 );
+            int regionId2 = table.regions->iget( globalIndex2 );
+
+            const MULTREGTRecord * record = lookup( table , regionId1 , regionId2 , allDirections );
+            if (!record)
+                record = lookup( table , regionId2 , regionId1 , allDirections );
 
+            if (record && record->m_nncBehaviour != MULTREGT::NONNC)
+                return record->m_transMultiplier;
         }
         return 1;
     }
+
+
+    std::vector< double > MULTREGTScanner::getRegionMultipliers(const GridDims& dims, FaceDir::DirEnum faceDir) const {
+        const size_t nx = dims.getNX();
+        const size_t ny = dims.getNY();
+        const size_t nz = dims.getNZ();
+        std::vector< double > multipliers( nx * ny * nz , 1.0 );
+
+        size_t stride;
+        switch (faceDir) {
+        case FaceDir::XPlus:
+            stride = 1;
+            break;
+        case FaceDir::YPlus:
+            stride = nx;
+            break;
+        case FaceDir::ZPlus:
+            stride = nx * ny;
+            break;
+        default:
+            throw std::invalid_argument("The region multipliers are only available for the XPlus, YPlus and ZPlus directions");
+        }
+
+        if (m_tables.empty())
+            return multipliers;
+
+        /*
+          The region values of all the cells, one array per table, for
+          the duration of this call only.
+        */
+        std::vector< std::vector< int > > regionValues;
+        for (const auto& table : m_tables) {
+            regionValues.emplace_back( multipliers.size() );
+            auto& values = regionValues.back();
+            table.regions->forEachRange( [&values]( size_t begin , size_t end , int value ) {
+                std::fill( values.begin() + begin , values.begin() + end , value );
+            });
+        }
+
+        parallel::for_each( multipliers.size() , [&]( size_t globalIndex ) {
+            const size_t i = globalIndex % nx;
+            const size_t j = globalIndex / nx % ny;
+            const size_t k = globalIndex / (nx * ny);
+
+            const bool boundary = (faceDir == FaceDir::XPlus && i + 1 == nx)
+                               || (faceDir == FaceDir::YPlus && j + 1 == ny)
+                               || (faceDir == FaceDir::ZPlus && k + 1 == nz);
+
+            if (boundary)
+                return;
+
+            for (size_t t = 0; t < m_tables.size(); t++) {
+                const MULTREGTRecord * record = applicable( m_tables[t] , globalIndex , globalIndex + stride ,
+                                                            regionValues[t][globalIndex] , regionValues[t][globalIndex + stride] , faceDir );
+                if (record) {
+                    multipliers[globalIndex] = record->m_transMultiplier;
+                    return;
+                }
+            }
+        }, 1 << 14 );
+
+        return multipliers;
+    }
 }
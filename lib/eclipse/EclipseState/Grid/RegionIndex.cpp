@@ -0,0 +1,133 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
+
+namespace Opm {
+
+    RegionIndex::RegionIndex( const GridProperty< int >& regions ) {
+        /*
+          The ranges are first collected in global order, and then
+          sorted into the region buckets with a counting sort over the
+          positions of the region values in the sorted list of
+          distinct values; the order within each region is kept.
+        */
+        std::vector< std::pair< size_t, size_t > > ranges;
+        std::vector< int > values;
+
+        regions.forEachRange( [&]( size_t begin, size_t end, int value ) {
+                ranges.emplace_back( begin, end );
+                values.push_back( value );
+            } );
+
+        m_regions = values;
+        std::sort( m_regions.begin(), m_regions.end() );
+        m_regions.erase( std::unique( m_regions.begin(), m_regions.end() ), m_regions.end() );
+
+        m_offsets.assign( m_regions.size() + 1, 0 );
+        if (ranges.empty())
+            return;
+
+        m_begins.reserve( ranges.size() );
+        for (const auto& range : ranges)
+            m_begins.push_back( range.first );
+        m_size = ranges.back().second;
+
+        std::vector< size_t > positions( values.size() );
+        for (size_t i = 0; i < values.size(); i++) {
+            positions[i] = position( values[i] );
+            m_offsets[ positions[i] + 1 ]++;
+        }
+
+        for (size_t r = 0; r < m_regions.size(); r++)
+            m_offsets[r + 1] += m_offsets[r];
+
+        std::vector< size_t > next( m_offsets.begin(), m_offsets.end() - 1 );
+        m_ranges.resize( ranges.size() );
+        for (size_t i = 0; i < ranges.size(); i++)
+            m_ranges[ next[ positions[i] ]++ ] = ranges[i];
+
+        m_values.swap( values );
+    }
+
+    size_t RegionIndex::position( int region ) const {
+        const auto pos = std::lower_bound( m_regions.begin(), m_regions.end(), region );
+        if (pos == m_regions.end() || *pos != region)
+            return m_regions.size();
+
+        return pos - m_regions.begin();
+    }
+
+    int RegionIndex::minRegion() const {
+        return m_regions.empty() ? 0 : m_regions.front();
+    }
+
+    int RegionIndex::maxRegion() const {
+        return m_regions.empty() ? -1 : m_regions.back();
+    }
+
+    std::vector< int > RegionIndex::regions() const {
+        return m_regions;
+    }
+
+    void RegionIndex::forEachRange( int region, const std::function< void( size_t, size_t ) >& f ) const {
+        const size_t r = position( region );
+        if (r == m_regions.size())
+            return;
+
+        for (size_t i = m_offsets[r]; i < m_offsets[r + 1]; i++)
+            f( m_ranges[i].first, m_ranges[i].second );
+    }
+
+    size_t RegionIndex::numCells( int region ) const {
+        size_t num_cells = 0;
+        forEachRange( region, [&num_cells]( size_t begin, size_t end ) { num_cells += end - begin; } );
+        return num_cells;
+    }
+
+    std::vector< size_t > RegionIndex::cells( int region ) const {
+        std::vector< size_t > cells;
+        cells.reserve( numCells( region ));
+        forEachRange( region, [&cells]( size_t begin, size_t end ) {
+                for (size_t g = begin; g < end; g++)
+                    cells.push_back( g );
+            } );
+        return cells;
+    }
+
+    int RegionIndex::region( size_t index ) const {
+        if (index >= m_size)
+            throw std::out_of_range("Index " + std::to_string( index ) + " out of range for region index");
+
+        const auto pos = std::upper_bound( m_begins.begin(), m_begins.end(), index );
+        return m_values[ pos - m_begins.begin() - 1 ];
+    }
+
+    void RegionIndex::forEachRange( const std::function< void( size_t, size_t, int ) >& f ) const {
+        for (size_t i = 0; i < m_begins.size(); i++) {
+            const size_t end = i + 1 < m_begins.size() ? m_begins[i + 1] : m_size;
+            f( m_begins[i], end, m_values[i] );
+        }
+    }
+}
@@ -20,6 +20,7 @@
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/SgfnTable.hpp>
@@ -678,425 +679,424 @@ namespace Opm {
         return value;
     }
 
-    static std::vector< double > satnumApply( size_t size,
-                                              const std::string& columnName,
-                                              const std::vector< double >& fallbackValues,
-                                              const TableManager* tableManager,
-                                              const EclipseGrid* eclipseGrid,
-                                              const GridProperties<int>* intGridProperties,
-                                              bool useOneMinusTableValue ) {
-
-
-        std::vector< double > values( size, 0 );
+    /*
+      Without ENPTVD/ENKRVD the endpoints only depend on the saturation
+      table of the cell, so they are given as one value per table and
+      looked up through the region index of the table number keyword;
+      the dense arrays are then only built if they are modified cell by
+      cell. With depth tables the values are evaluated for each cell.
+    */
+    static GridPropertyLookup< double > tableApply( size_t size,
+                                                    const std::string& regionKeyword,
+                                                    const std::string& columnName,
+                                                    const std::vector< double >& fallbackValues,
+                                                    bool useDepthTables,
+                                                    const TableContainer& depthTables,
+                                                    const TableManager* tableManager,
+                                                    const EclipseGrid* eclipseGrid,
+                                                    const GridProperties<int>* intGridProperties,
+                                                    bool useOneMinusTableValue ) {
+
+        GridPropertyLookup< double > lookup;
         auto tabdims = tableManager->getTabdims();
 
-        const auto& satnum = intGridProperties->getKeyword("SATNUM");
-        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
+        const auto& tablenum = intGridProperties->getKeyword( regionKeyword );
         int numSatTables = tabdims.getNumSatTables();
 
-        satnum.checkLimits( 1 , numSatTables );
+        tablenum.checkLimits( 1 , numSatTables );
+
+        if( !useDepthTables ) {
+            lookup.regions = tablenum.regionIndex();
+            lookup.values = fallbackValues;
+            return lookup;
+        }
 
         // acctually assign the defaults. if the ENPVD keyword was specified in the deck,
         // this currently cannot be done because we would need the Z-coordinate of the
         // cell and we would need to know how the simulator wants to interpolate between
         // sampling points. Both of these are outside the scope of opm-parser, so we just
         // assign a NaN in this case...
-        const bool useEnptvd = tableManager->useEnptvd();
-        const auto& enptvdTables = tableManager->getEnptvdTables();
+        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
+        lookup.values.assign( size, 0 );
 
         const auto gridsize = eclipseGrid->getCartesianSize();
+        const auto& depth = eclipseGrid->getGeometry().getDepth();
         for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
-            int satTableIdx = satnum.iget( cellIdx ) - 1;
+            int tableIdx = tablenum.iget( cellIdx ) - 1;
             int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
-
-
-            values[cellIdx] = selectValue(enptvdTables,
-                                        (useEnptvd && endNum >= 0) ? endNum : -1,
-                                        columnName,
-                                        cellDepth,
-                                        fallbackValues[ satTableIdx ],
-                                        useOneMinusTableValue);
+            double cellDepth = depth[ cellIdx ];
+
+            lookup.values[cellIdx] = selectValue(depthTables,
+                                                 endNum >= 0 ? endNum : -1,
+                                                 columnName,
+                                                 cellDepth,
+                                                 fallbackValues[ tableIdx ],
+                                                 useOneMinusTableValue);
         }
 
-        return values;
+        return lookup;
     }
 
-    static std::vector< double > imbnumApply( size_t size,
-                                              const std::string& columnName,
-                                              const std::vector< double >& fallBackValues,
-                                              const TableManager* tableManager,
-                                              const EclipseGrid* eclipseGrid,
-                                              const GridProperties<int>* intGridProperties,
-                                              bool useOneMinusTableValue ) {
-
-        std::vector< double > values( size, 0 );
-
-        const auto& imbnum = intGridProperties->getKeyword("IMBNUM");
-        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
-
-        auto tabdims = tableManager->getTabdims();
-        const int numSatTables = tabdims.getNumSatTables();
-
-        imbnum.checkLimits( 1 , numSatTables );
-        // acctually assign the defaults. if the ENPVD keyword was specified in the deck,
-        // this currently cannot be done because we would need the Z-coordinate of the
-        // cell and we would need to know how the simulator wants to interpolate between
-        // sampling points. Both of these are outside the scope of opm-parser, so we just
-        // assign a NaN in this case...
-        const bool useImptvd = tableManager->useImptvd();
-        const TableContainer& imptvdTables = tableManager->getImptvdTables();
-        const auto gridsize = eclipseGrid->getCartesianSize();
-        for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
-            int imbTableIdx = imbnum.iget( cellIdx ) - 1;
-            int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
-
-            values[cellIdx] = selectValue(imptvdTables,
-                                                (useImptvd && endNum >= 0) ? endNum : -1,
-                                                columnName,
-                                                cellDepth,
-                                                fallBackValues[imbTableIdx],
-                                                useOneMinusTableValue);
-        }
+    static GridPropertyLookup< double > satnumApply( size_t size,
+                                                     const std::string& columnName,
+                                                     const std::vector< double >& fallbackValues,
+                                                     const TableManager* tableManager,
+                                                     const EclipseGrid* eclipseGrid,
+                                                     const GridProperties<int>* intGridProperties,
+                                                     bool useOneMinusTableValue ) {
+
+        return tableApply( size, "SATNUM", columnName, fallbackValues,
+                           tableManager->useEnptvd(), tableManager->getEnptvdTables(),
+                           tableManager, eclipseGrid, intGridProperties, useOneMinusTableValue );
+    }
 
-        return values;
+    static GridPropertyLookup< double > imbnumApply( size_t size,
+                                                     const std::string& columnName,
+                                                     const std::vector< double >& fallbackValues,
+                                                     const TableManager* tableManager,
+                                                     const EclipseGrid* eclipseGrid,
+                                                     const GridProperties<int>* intGridProperties,
+                                                     bool useOneMinusTableValue ) {
+
+        return tableApply( size, "IMBNUM", columnName, fallbackValues,
+                           tableManager->useImptvd(), tableManager->getImptvdTables(),
+                           tableManager, eclipseGrid, intGridProperties, useOneMinusTableValue );
     }
 
-    std::vector< double > SGLEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid* eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SGLEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid* eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto min_gas = findMinGasSaturation( tableManager );
         return satnumApply( size, "SGCO", min_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISGLEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid* eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISGLEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid* eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto min_gas = findMinGasSaturation( tableManager );
         return imbnumApply( size, "SGCO", min_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > SGUEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid* eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SGUEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid* eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_gas = findMaxGasSaturation( tableManager );
         return satnumApply( size, "SGMAX", max_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISGUEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid* eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISGUEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid* eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto max_gas = findMaxGasSaturation( tableManager );
         return imbnumApply( size, "SGMAX", max_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > SWLEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid* eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SWLEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid* eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto min_water = findMinWaterSaturation( tableManager );
         return satnumApply( size, "SWCO", min_water, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISWLEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISWLEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto min_water = findMinWaterSaturation( tableManager );
         return imbnumApply( size, "SWCO", min_water, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > SWUEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid  * eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SWUEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid  * eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_water = findMaxWaterSaturation( tableManager );
         return satnumApply( size, "SWMAX", max_water, tableManager, eclipseGrid,
                             intGridProperties, true );
     }
 
-    std::vector< double > ISWUEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISWUEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto max_water = findMaxWaterSaturation( tableManager );
         return imbnumApply( size, "SWMAX", max_water, tableManager, eclipseGrid,
                             intGridProperties, true);
     }
 
-    std::vector< double > SGCREndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SGCREndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto crit_gas = findCriticalGas( tableManager );
         return satnumApply( size, "SGCRIT", crit_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISGCREndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISGCREndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto crit_gas = findCriticalGas( tableManager );
         return imbnumApply( size, "SGCRIT", crit_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > SOWCREndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SOWCREndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto oil_water = findCriticalOilWater( tableManager );
         return satnumApply( size, "SOWCRIT", oil_water, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISOWCREndpoint( size_t size,
-                                          const TableManager * tableManager,
-                                          const EclipseGrid  * eclipseGrid,
-                                          GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISOWCREndpoint( size_t size,
+                                                 const TableManager * tableManager,
+                                                 const EclipseGrid  * eclipseGrid,
+                                                 GridProperties<int>* intGridProperties )
     {
         const auto oil_water = findCriticalOilWater( tableManager );
         return imbnumApply( size, "SOWCRIT", oil_water, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > SOGCREndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SOGCREndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto crit_oil_gas = findCriticalOilGas( tableManager );
         return satnumApply( size, "SOGCRIT", crit_oil_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISOGCREndpoint( size_t size,
-                                          const TableManager * tableManager,
-                                          const EclipseGrid  * eclipseGrid,
-                                          GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISOGCREndpoint( size_t size,
+                                                 const TableManager * tableManager,
+                                                 const EclipseGrid  * eclipseGrid,
+                                                 GridProperties<int>* intGridProperties )
     {
         const auto crit_oil_gas = findCriticalOilGas( tableManager );
         return imbnumApply( size, "SOGCRIT", crit_oil_gas, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > SWCREndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > SWCREndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto crit_water = findCriticalWater( tableManager );
         return satnumApply( size, "SWCRIT", crit_water, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > ISWCREndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > ISWCREndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto crit_water = findCriticalWater( tableManager );
         return imbnumApply( size, "SWCRIT", crit_water, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > PCWEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid  * eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > PCWEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid  * eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_pcow = findMaxPcow( tableManager );
         return satnumApply( size, "PCW", max_pcow, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IPCWEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IPCWEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto max_pcow = findMaxPcow( tableManager );
         return imbnumApply( size, "IPCW", max_pcow, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > PCGEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid  * eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > PCGEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid  * eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_pcog = findMaxPcog( tableManager );
         return satnumApply( size, "PCG", max_pcog, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IPCGEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IPCGEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto max_pcog = findMaxPcog( tableManager );
         return imbnumApply( size, "IPCG", max_pcog, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KRWEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid  * eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KRWEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid  * eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_krw = findMaxKrw( tableManager );
         return satnumApply( size, "KRW", max_krw, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKRWEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKRWEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto krwr = findKrwr( tableManager );
         return imbnumApply( size, "IKRW", krwr, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KRWREndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KRWREndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto krwr = findKrwr( tableManager );
         return satnumApply( size, "KRWR", krwr, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKRWREndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKRWREndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto krwr = findKrwr( tableManager );
         return imbnumApply( size, "IKRWR", krwr, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KROEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid  * eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KROEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid  * eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_kro = findMaxKro( tableManager );
         return satnumApply( size, "KRO", max_kro, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKROEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKROEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto max_kro = findMaxKro( tableManager );
         return imbnumApply( size, "IKRO", max_kro, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KRORWEndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KRORWEndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto krorw = findKrorw( tableManager );
         return satnumApply( size, "KRORW", krorw, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKRORWEndpoint( size_t size,
-                                          const TableManager * tableManager,
-                                          const EclipseGrid  * eclipseGrid,
-                                          GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKRORWEndpoint( size_t size,
+                                                 const TableManager * tableManager,
+                                                 const EclipseGrid  * eclipseGrid,
+                                                 GridProperties<int>* intGridProperties )
     {
         const auto krorw = findKrorw( tableManager );
         return imbnumApply( size, "IKRORW", krorw, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KRORGEndpoint( size_t size,
-                                         const TableManager * tableManager,
-                                         const EclipseGrid  * eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KRORGEndpoint( size_t size,
+                                                const TableManager * tableManager,
+                                                const EclipseGrid  * eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto krorg = findKrorg( tableManager );
         return satnumApply( size, "KRORG", krorg, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKRORGEndpoint( size_t size,
-                                          const TableManager * tableManager,
-                                          const EclipseGrid  * eclipseGrid,
-                                          GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKRORGEndpoint( size_t size,
+                                                 const TableManager * tableManager,
+                                                 const EclipseGrid  * eclipseGrid,
+                                                 GridProperties<int>* intGridProperties )
     {
         const auto krorg = findKrorg( tableManager );
         return imbnumApply( size, "IKRORG", krorg, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KRGEndpoint( size_t size,
-                                       const TableManager * tableManager,
-                                       const EclipseGrid  * eclipseGrid,
-                                       GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KRGEndpoint( size_t size,
+                                              const TableManager * tableManager,
+                                              const EclipseGrid  * eclipseGrid,
+                                              GridProperties<int>* intGridProperties )
     {
         const auto max_krg = findMaxKrg( tableManager );
         return satnumApply( size, "KRG", max_krg, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKRGEndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKRGEndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto max_krg = findMaxKrg( tableManager );
         return imbnumApply( size, "IKRG", max_krg, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > KRGREndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                        const EclipseGrid  * eclipseGrid,
-                                        GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > KRGREndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                               const EclipseGrid  * eclipseGrid,
+                                               GridProperties<int>* intGridProperties )
     {
         const auto krgr = findKrgr( tableManager );
         return satnumApply( size, "KRGR", krgr, tableManager, eclipseGrid,
                             intGridProperties, false );
     }
 
-    std::vector< double > IKRGREndpoint( size_t size,
-                                        const TableManager * tableManager,
-                                         const EclipseGrid* eclipseGrid,
-                                         GridProperties<int>* intGridProperties )
+    GridPropertyLookup< double > IKRGREndpoint( size_t size,
+                                               const TableManager * tableManager,
+                                                const EclipseGrid* eclipseGrid,
+                                                GridProperties<int>* intGridProperties )
     {
         const auto krgr = findKrgr( tableManager );
         return imbnumApply( size, "IKRGR", krgr, tableManager, eclipseGrid,
@@ -17,10 +17,12 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
@@ -28,20 +30,33 @@
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 
 
 namespace Opm {
 
+namespace {
+
+    /* The position of the direction in the array of multipliers */
+    size_t directionIndex(FaceDir::DirEnum faceDir) {
+        switch (faceDir) {
+        case FaceDir::XPlus:  return 0;
+        case FaceDir::XMinus: return 1;
+        case FaceDir::YPlus:  return 2;
+        case FaceDir::YMinus: return 3;
+        case FaceDir::ZPlus:  return 4;
+        case FaceDir::ZMinus: return 5;
+        }
+
+        throw std::invalid_argument("Invalid face direction");
+    }
+
+}
+
     TransMult::TransMult(const GridDims& dims, const Deck& deck, const Eclipse3DProperties& props) :
         m_nx( dims.getNX()),
         m_ny( dims.getNY()),
         m_nz( dims.getNZ()),
-        m_names( { { FaceDir::XPlus,  "MULTX"  },
-                   { FaceDir::YPlus,  "MULTY"  },
-                   { FaceDir::ZPlus,  "MULTZ"  },
-                   { FaceDir::XMinus, "MULTX-" },
-                   { FaceDir::YMinus, "MULTY-" },
-                   { FaceDir::ZMinus, "MULTZ-" }}),
         m_multregtScanner( props, deck.getKeywordList( "MULTREGT" ))
     {
     }
@@ -66,10 +81,11 @@ namespace Opm {
     }
 
     double TransMult::getMultiplier__(size_t globalIndex,  FaceDir::DirEnum faceDir) const {
-        if (hasDirectionProperty( faceDir )) {
-            return m_trans.at(faceDir).iget( globalIndex );
-        } else
+        const auto& multipliers = m_trans[ directionIndex( faceDir ) ];
+        if (multipliers.empty())
             return 1.0;
+
+        return multipliers[ globalIndex ];
     }
 
 
@@ -84,53 +100,99 @@ namespace Opm {
         return m_multregtScanner.getRegionMultiplier(globalCellIndex1, globalCellIndex2, faceDir);
     }
 
-    bool TransMult::hasDirectionProperty(FaceDir::DirEnum faceDir) const {
-        return m_trans.count(faceDir) == 1;
+    std::vector< double > TransMult::getRegionMultipliers( FaceDir::DirEnum faceDir ) const {
+        return m_multregtScanner.getRegionMultipliers( GridDims( m_nx, m_ny, m_nz ), faceDir );
+    }
+
+    double TransMult::getNNCMultiplier(size_t globalCellIndex1, size_t globalCellIndex2) const {
+        return m_multregtScanner.getNNCMultiplier(globalCellIndex1, globalCellIndex2);
+    }
+
+    bool TransMult::isUniform(FaceDir::DirEnum faceDir) const {
+        return m_trans[ directionIndex( faceDir ) ].empty();
+    }
+
+    const std::vector<double>& TransMult::getMultipliers(FaceDir::DirEnum faceDir) const {
+        return m_trans[ directionIndex( faceDir ) ];
     }
 
-    void TransMult::insertNewProperty(FaceDir::DirEnum faceDir) {
-        GridPropertySupportedKeywordInfo<double> kwInfo(m_names[faceDir] , 1.0 , "1");
-        GridProperty< double > prop( m_nx, m_ny, m_nz, kwInfo );
-        m_trans.emplace( faceDir, std::move( prop ) );
+    std::vector<double> TransMult::getActiveMultipliers(const EclipseGrid& grid, FaceDir::DirEnum faceDir) const {
+        const auto& multipliers = m_trans[ directionIndex( faceDir ) ];
+        if (multipliers.empty())
+            return std::vector<double>( grid.getNumActive() , 1.0 );
+
+        return grid.compressedVector( multipliers );
     }
 
 
-    GridProperty<double>& TransMult::getDirectionProperty(FaceDir::DirEnum faceDir) {
-        if (m_trans.count(faceDir) == 0)
-            insertNewProperty(faceDir);
+    std::vector<double>& TransMult::getDirectionMultipliers(FaceDir::DirEnum faceDir) {
+        auto& multipliers = m_trans[ directionIndex( faceDir ) ];
+        if (multipliers.empty())
+            multipliers.assign( m_nx * m_ny * m_nz , 1.0 );
 
-        return m_trans.at( faceDir );
+        return multipliers;
     }
 
     void TransMult::applyMULT(const GridProperty<double>& srcProp, FaceDir::DirEnum faceDir)
     {
-        auto& dstProp = getDirectionProperty(faceDir);
+        auto& multipliers = getDirectionMultipliers(faceDir);
 
         const std::vector<double> &srcData = srcProp.getData();
-        for (size_t i = 0; i < srcData.size(); ++i)
-            dstProp.multiplyValueAtIndex(i, srcData[i]);
-    }
+        if (srcData.size() != multipliers.size())
+            throw std::invalid_argument("Size mismatch between the multiplier property and the grid");
 
+        parallel::for_ranges( srcData.size(), [&]( size_t begin, size_t end ) {
+            for (size_t i = begin; i < end; ++i)
+                multipliers[i] *= srcData[i];
+        }, 1 << 16 );
+    }
 
-    void TransMult::applyMULTFLT(const Fault& fault) {
-        double transMult = fault.getTransMult();
 
-        for( const auto& face : fault ) {
-            FaceDir::DirEnum faceDir = face.getDir();
-            auto& multProperty = getDirectionProperty(faceDir);
+    void TransMult::applyMULTFLT(const std::vector< std::pair< const Fault*, double > >& faultFactors) {
+        for (const auto& fault_factor : faultFactors)
+            for (const auto& face : *fault_factor.first)
+                getDirectionMultipliers( face.getDir() );
+
+        /*
+          The faces are applied in parallel over slabs of layers, every
+          thread clips all the faces to its own layers. Several faults
+          can share faces, and applying them in the same thread keeps
+          the multiplications free of races.
+        */
+        const size_t layer = m_nx * m_ny;
+        parallel::for_ranges( m_nz, [&]( size_t kbegin, size_t kend ) {
+            for (const auto& fault_factor : faultFactors) {
+                const double factor = fault_factor.second;
+
+                for (const auto& face : *fault_factor.first) {
+                    auto& multipliers = m_trans[ directionIndex( face.getDir() ) ];
+                    const size_t k1 = std::max( kbegin , face.getK1() );
+                    const size_t k2 = std::min( kend , face.getK2() + 1 );
+
+                    for (size_t k = k1; k < k2; k++)
+                        for (size_t j = face.getJ1(); j <= face.getJ2(); j++) {
+                            const size_t row = j * m_nx + k * layer;
+                            for (size_t i = face.getI1(); i <= face.getI2(); i++)
+                                multipliers[ row + i ] *= factor;
+                        }
+                }
+            }
+        }, std::max< size_t >( 1 , (1 << 16) / std::max< size_t >( layer , 1 )));
+    }
 
 
-            for( auto globalIndex : face ) {
-                multProperty.multiplyValueAtIndex( globalIndex , transMult);
-            }
-        }
+    void TransMult::applyMULTFLT(const Fault& fault) {
+        applyMULTFLT( { std::make_pair( &fault , fault.getTransMult() ) } );
     }
 
 
     void TransMult::applyMULTFLT(const FaultCollection& faults) {
+        std::vector< std::pair< const Fault*, double > > faultFactors;
         for (size_t faultIndex = 0; faultIndex < faults.size(); faultIndex++) {
             auto& fault = faults.getFault(faultIndex);
-            applyMULTFLT(fault);
+            faultFactors.emplace_back( &fault , fault.getTransMult() );
         }
+
+        applyMULTFLT( faultFactors );
     }
     }
@@ -256,7 +256,7 @@ namespace Opm {
                     m_events.addEvent( ScheduleEvents::GEO_MODIFIER , currentStep);
                 } else {
                     std::string msg = "OPM does not support grid property modifier " + keyword.name() + " in the Schedule section. Error at report: " + std::to_string( currentStep );
-                    parseContext.handleError( ParseContext::UNSUPPORTED_SCHEDULE_GEO_MODIFIER , m_messages, msg );
+                    parseContext.handleError( ParseContext::ErrorKey::UNSUPPORTED_SCHEDULE_GEO_MODIFIER , m_messages, msg );
                 }
             }
         }
@@ -299,7 +299,7 @@ namespace Opm {
             if (bhp_terminate == "YES") {
                 std::string msg = "The WHISTCTL keyword does not handle 'YES'. i.e. to terminate the run";
                 m_messages.error(msg);
-                parseContext.handleError( ParseContext::UNSUPPORTED_TERMINATE_IF_BHP , m_messages, msg );
+                parseContext.handleError( ParseContext::ErrorKey::UNSUPPORTED_TERMINATE_IF_BHP , m_messages, msg );
             }
 
         }
@@ -312,7 +312,7 @@ namespace Opm {
             if ((methodItem.get< std::string >(0) != "TRACK")  && (methodItem.get< std::string >(0) != "INPUT")) {
                 std::string msg = "The COMPORD keyword only handles 'TRACK' or 'INPUT' order.";
                 m_messages.error(msg);
-                parseContext.handleError( ParseContext::UNSUPPORTED_COMPORD_TYPE , m_messages, msg );
+                parseContext.handleError( ParseContext::ErrorKey::UNSUPPORTED_COMPORD_TYPE , m_messages, msg );
             }
         }
     }
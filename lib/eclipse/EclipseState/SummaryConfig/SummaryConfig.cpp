@@ -151,7 +151,7 @@ void handleMissingWell( const ParseContext& parseContext , const std::string& ke
     if (parseContext.get( ParseContext::SUMMARY_UNKNOWN_WELL) == InputError::WARN)
         std::cerr << "ERROR: " << msg << std::endl;
 
-    parseContext.handleError( ParseContext::SUMMARY_UNKNOWN_WELL , msgContainer , msg );
+    parseContext.handleError( ParseContext::ErrorKey::SUMMARY_UNKNOWN_WELL , msgContainer , msg );
 }
 
 
@@ -161,7 +161,7 @@ void handleMissingGroup( const ParseContext& parseContext , const std::string& k
     if (parseContext.get( ParseContext::SUMMARY_UNKNOWN_GROUP) == InputError::WARN)
         std::cerr << "ERROR: " << msg << std::endl;
 
-    parseContext.handleError( ParseContext::SUMMARY_UNKNOWN_GROUP , msgContainer , msg );
+    parseContext.handleError( ParseContext::ErrorKey::SUMMARY_UNKNOWN_GROUP , msgContainer , msg );
 }
 
 inline void keywordW( std::vector< ERT::smspec_node >& list,
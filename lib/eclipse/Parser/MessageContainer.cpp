@@ -20,10 +20,13 @@
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 
 #include <memory>
+#include <stdexcept>
 
 
 namespace Opm {
 
+    const size_t MessageContainer::defaultCategoryLimit;
+
     Location::Location( const std::string& fn, size_t ln ) :
         filename( fn ), lineno( ln )
     {
@@ -32,113 +35,229 @@ namespace Opm {
                                          + fn + "'" );
     }
 
+namespace {
+
+    size_t hash_combine( size_t seed, size_t value ) {
+        return seed ^ ( value + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 ) );
+    }
+
+    /*
+      The hash of where a message is reported from - everything but the
+      message text, which the lazy add() overloads do not know up front.
+    */
+    size_t site_hash( const std::string& category, Message::type mtype,
+                      const std::string& filename, size_t lineno ) {
+        size_t h = std::hash< std::string >()( category );
+        h = hash_combine( h, std::hash< std::string >()( filename ) );
+        h = hash_combine( h, lineno );
+        return hash_combine( h, size_t( mtype ) );
+    }
+
+    size_t message_hash( const Message& msg ) {
+        size_t h = std::hash< std::string >()( msg.message );
+        h = hash_combine( h, std::hash< std::string >()( msg.category ) );
+        h = hash_combine( h, std::hash< std::string >()( msg.location.filename ) );
+        h = hash_combine( h, msg.location.lineno );
+        return hash_combine( h, size_t( msg.mtype ) );
+    }
+
+    bool same_message( const Message& lhs, const Message& rhs ) {
+        return lhs.mtype == rhs.mtype
+            && lhs.location.lineno == rhs.location.lineno
+            && lhs.message == rhs.message
+            && lhs.category == rhs.category
+            && lhs.location.filename == rhs.location.filename;
+    }
+
+}
+
     void MessageContainer::error( const std::string& msg,
                                   const std::string& filename,
                                   const size_t lineno ) {
-        m_messages.emplace_back(
-            Message { Message::Error, msg, Location { filename, lineno } }
-        );
+        this->insert( Message { Message::Error, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::error( const std::string& msg ) {
-        m_messages.emplace_back( Message { Message::Error, msg, {} } );
+        this->insert( Message { Message::Error, msg } );
     }
 
 
     void MessageContainer::bug( const std::string& msg,
                                 const std::string& filename,
                                 const size_t lineno ) {
-        m_messages.emplace_back(
-            Message { Message::Bug, msg, { filename, lineno } }
-        );
+        this->insert( Message { Message::Bug, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::bug( const std::string& msg ) {
-        m_messages.emplace_back( Message { Message::Bug, msg, {} } );
+        this->insert( Message { Message::Bug, msg } );
     }
 
 
     void MessageContainer::warning( const std::string& msg,
                                     const std::string& filename,
                                     const size_t lineno ) {
-        m_messages.emplace_back( Message {
-                Message::Warning, msg, { filename, lineno }
-            }
-        );
+        this->insert( Message { Message::Warning, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::warning( const std::string& msg ) {
-        m_messages.emplace_back(
-            Message { Message::Warning, msg,{} }
-        );
+        this->insert( Message { Message::Warning, msg } );
     }
 
 
-
     void MessageContainer::info( const std::string& msg,
                                  const std::string& filename,
                                  const size_t lineno ) {
-        m_messages.emplace_back(
-            Message { Message::Info, msg, { filename, lineno } }
-        );
+        this->insert( Message { Message::Info, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::info( const std::string& msg ) {
-        m_messages.emplace_back( Message { Message::Info, msg, {} } );
+        this->insert( Message { Message::Info, msg } );
     }
 
 
     void MessageContainer::debug( const std::string& msg,
                                   const std::string& filename,
                                   const size_t lineno ) {
-        m_messages.emplace_back(
-            Message { Message::Debug, msg, { filename, lineno } }
-        );
+        this->insert( Message { Message::Debug, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::debug( const std::string& msg ) {
-        m_messages.emplace_back( Message { Message::Debug, msg, {} } );
+        this->insert( Message { Message::Debug, msg } );
     }
 
 
     void MessageContainer::problem( const std::string& msg,
                                     const std::string& filename,
                                     const size_t lineno ) {
-        m_messages.emplace_back(
-            Message { Message::Problem, msg, { filename, lineno } }
-        );
+        this->insert( Message { Message::Problem, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::problem( const std::string& msg ) {
-        m_messages.emplace_back( Message { Message::Problem, msg, {} } );
+        this->insert( Message { Message::Problem, msg } );
     }
 
 
     void MessageContainer::note( const std::string& msg,
                                  const std::string& filename,
                                  const size_t lineno ) {
-        m_messages.emplace_back(
-            Message { Message::Note, msg, { filename, lineno } }
-        );
+        this->insert( Message { Message::Note, msg, Location { filename, lineno } } );
     }
 
 
     void MessageContainer::note( const std::string& msg ) {
-        m_messages.emplace_back( Message { Message::Note, msg, {} } );
+        this->insert( Message { Message::Note, msg } );
     }
 
 
     void MessageContainer::add( const Message& msg ) {
-        this->m_messages.push_back( msg );
+        this->insert( Message( msg ) );
     }
 
     void MessageContainer::add( Message&& msg ) {
+        this->insert( std::move( msg ) );
+    }
+
+
+    void MessageContainer::add( const std::string& category,
+                                Message::type mtype,
+                                const std::string& msg ) {
+        Message message { mtype, msg };
+        message.category = category;
+        this->insert( std::move( message ) );
+    }
+
+
+    void MessageContainer::add( const std::string& category,
+                                Message::type mtype,
+                                const formatter& msg ) {
+        if( this->full( category ) && !this->stored( category, mtype, "", 0 ) ) {
+            auto& counter = this->m_categories[ category ];
+            counter.reported++;
+            counter.dropped++;
+            return;
+        }
+
+        this->add( category, mtype, msg() );
+    }
+
+
+    void MessageContainer::add( const std::string& category,
+                                Message::type mtype,
+                                const formatter& msg,
+                                const std::string& filename,
+                                const size_t lineno ) {
+        if( this->full( category ) && !this->stored( category, mtype, filename, lineno ) ) {
+            auto& counter = this->m_categories[ category ];
+            counter.reported++;
+            counter.dropped++;
+            return;
+        }
+
+        Message message { mtype, msg(), Location { filename, lineno } };
+        message.category = category;
+        this->insert( std::move( message ) );
+    }
+
+
+    bool MessageContainer::full( const std::string& category ) const {
+        if( category.empty() ) return false;
+
+        const auto counter = this->m_categories.find( category );
+        if( counter == this->m_categories.end() ) return false;
+
+        return counter->second.stored >= this->m_limit;
+    }
+
+
+    /*
+      Whether a message from this category, type and location has been
+      stored. When a category is full the lazy add() overloads only format
+      a message if this holds, since only then can it be a repeat of a
+      stored message, whose count must be bumped; hash collisions only
+      cause an unnecessary formatting.
+    */
+    bool MessageContainer::stored( const std::string& category,
+                                   Message::type mtype,
+                                   const std::string& filename,
+                                   const size_t lineno ) const {
+        return this->m_sites.count( site_hash( category, mtype, filename, lineno ) ) > 0;
+    }
+
+
+    /*
+      All messages go through insert(); a message identical to one already
+      stored only bumps the count of the stored message, and messages in a
+      category which has reached the limit are counted and then dropped.
+    */
+    void MessageContainer::insert( Message&& msg ) {
+        auto& counter = this->m_categories[ msg.category ];
+        counter.reported += msg.count;
+
+        const auto hash = message_hash( msg );
+        const auto range = this->m_index.equal_range( hash );
+        for( auto iter = range.first; iter != range.second; ++iter ) {
+            auto& stored = this->m_messages[ iter->second ];
+            if( !same_message( stored, msg ) ) continue;
+
+            stored.count += msg.count;
+            return;
+        }
+
+        if( !msg.category.empty() && counter.stored >= this->m_limit ) {
+            counter.dropped += msg.count;
+            return;
+        }
+
+        counter.stored++;
+        this->m_sites.insert( site_hash( msg.category, msg.mtype,
+                                         msg.location.filename, msg.location.lineno ) );
+        this->m_index.emplace( hash, this->m_messages.size() );
         this->m_messages.push_back( std::move( msg ) );
     }
 
@@ -148,6 +267,54 @@ namespace Opm {
         for(const auto& msg : other) {
             this->add(msg);
         }
+
+        for( const auto& category : other.m_categories ) {
+            auto& counter = this->m_categories[ category.first ];
+            counter.reported += category.second.dropped;
+            counter.dropped += category.second.dropped;
+        }
+    }
+
+
+    void MessageContainer::appendMessages(MessageContainer&& other)
+    {
+        for(auto& msg : other.m_messages) {
+            this->insert( std::move( msg ) );
+        }
+
+        for( const auto& category : other.m_categories ) {
+            auto& counter = this->m_categories[ category.first ];
+            counter.reported += category.second.dropped;
+            counter.dropped += category.second.dropped;
+        }
+
+        other.m_messages.clear();
+        other.m_index.clear();
+        other.m_sites.clear();
+        other.m_categories.clear();
+    }
+
+
+    void MessageContainer::setCategoryLimit( size_t limit ) {
+        this->m_limit = limit;
+    }
+
+    size_t MessageContainer::getCategoryLimit() const {
+        return this->m_limit;
+    }
+
+    size_t MessageContainer::count( const std::string& category ) const {
+        const auto counter = this->m_categories.find( category );
+        if( counter == this->m_categories.end() ) return 0;
+
+        return counter->second.reported;
+    }
+
+    size_t MessageContainer::dropped( const std::string& category ) const {
+        const auto counter = this->m_categories.find( category );
+        if( counter == this->m_categories.end() ) return 0;
+
+        return counter->second.dropped;
     }
 
 
@@ -162,6 +329,6 @@ namespace Opm {
     std::size_t MessageContainer::size() const {
         return m_messages.size();
     }
-    
+
 
 } // namespace Opm
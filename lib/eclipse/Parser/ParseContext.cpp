@@ -68,6 +68,8 @@ namespace Opm {
     }
 
     void ParseContext::initDefault() {
+        m_actions.assign( static_cast< size_t >( ErrorKey::NUM_KEYS ), InputError::THROW_EXCEPTION );
+
         addKey(PARSE_UNKNOWN_KEYWORD);
         addKey(PARSE_RANDOM_TEXT);
         addKey(PARSE_RANDOM_SLASH);
@@ -98,16 +100,48 @@ namespace Opm {
             MessageContainer& msgContainer,
             const std::string& msg ) const {
 
-        InputError::Action action = get( errorKey );
+        return this->handleError( get( errorKey ), errorKey, msgContainer, [&msg]() { return msg; } );
+    }
+
+    Message::type ParseContext::handleError(
+            const std::string& errorKey,
+            MessageContainer& msgContainer,
+            const MessageContainer::formatter& msg ) const {
+
+        return this->handleError( get( errorKey ), errorKey, msgContainer, msg );
+    }
+
+    Message::type ParseContext::handleError(
+            ErrorKey errorKey,
+            MessageContainer& msgContainer,
+            const std::string& msg ) const {
+
+        return this->handleError( get( errorKey ), keyName( errorKey ), msgContainer, [&msg]() { return msg; } );
+    }
+
+    Message::type ParseContext::handleError(
+            ErrorKey errorKey,
+            MessageContainer& msgContainer,
+            const MessageContainer::formatter& msg ) const {
+
+        return this->handleError( get( errorKey ), keyName( errorKey ), msgContainer, msg );
+    }
+
+    Message::type ParseContext::handleError(
+            InputError::Action action,
+            const std::string& errorKey,
+            MessageContainer& msgContainer,
+            const MessageContainer::formatter& msg ) const {
 
         if (action == InputError::WARN) {
-            msgContainer.warning(msg);
+            msgContainer.add( errorKey, Message::Warning, msg );
             return Message::Warning;
         }
 
         else if (action == InputError::THROW_EXCEPTION) {
-            msgContainer.error(msg);
-            throw std::invalid_argument(errorKey + ": " + msg);
+            const auto text = msg();
+            msgContainer.add( errorKey, Message::Error, text );
+            throw std::invalid_argument(errorKey + ": " + text);
         }
 
         return Message::Debug;
@@ -149,7 +183,7 @@ namespace Opm {
             throw std::invalid_argument("The ParseContext keys can not contain '|', '*' or ':'");
 
         if (!hasKey(key))
-            m_errorContexts.insert( std::pair<std::string , InputError::Action>( key , InputError::THROW_EXCEPTION ));
+            setAction( key , InputError::THROW_EXCEPTION );
     }
 
 
@@ -160,6 +194,52 @@ namespace Opm {
             throw std::invalid_argument("The errormode key: " + key + " has not been registered");
     }
 
+
+    InputError::Action ParseContext::get(ErrorKey key) const {
+        return m_actions[ static_cast< size_t >( key ) ];
+    }
+
+
+    const std::string& ParseContext::keyName(ErrorKey key) {
+        static const std::string* const names[] = {
+            &PARSE_UNKNOWN_KEYWORD,
+            &PARSE_RANDOM_TEXT,
+            &PARSE_RANDOM_SLASH,
+            &PARSE_MISSING_DIMS_KEYWORD,
+            &PARSE_EXTRA_DATA,
+            &PARSE_MISSING_INCLUDE,
+            &UNSUPPORTED_SCHEDULE_GEO_MODIFIER,
+            &UNSUPPORTED_COMPORD_TYPE,
+            &UNSUPPORTED_INITIAL_THPRES,
+            &UNSUPPORTED_TERMINATE_IF_BHP,
+            &INTERNAL_ERROR_UNINITIALIZED_THPRES,
+            &SUMMARY_UNKNOWN_WELL,
+            &SUMMARY_UNKNOWN_GROUP
+        };
+
+        static_assert( sizeof( names ) / sizeof( names[ 0 ] ) == static_cast< size_t >( ErrorKey::NUM_KEYS ),
+                       "All ParseContext::ErrorKey ids must have a name" );
+
+        return *names[ static_cast< size_t >( key ) ];
+    }
+
+
+    /*
+      All updates of the actions go through setAction(), which keeps the
+      dense id indexed array in sync with the string keyed map.
+    */
+
+    void ParseContext::setAction( const std::string& key , InputError::Action action ) {
+        m_errorContexts[ key ] = action;
+
+        for (size_t id = 0; id < m_actions.size(); id++) {
+            if (keyName( static_cast< ErrorKey >( id ) ) == key) {
+                m_actions[ id ] = action;
+                break;
+            }
+        }
+    }
+
     /*****************************************************************/
 
     /*
@@ -176,7 +256,7 @@ namespace Opm {
 
     void ParseContext::updateKey(const std::string& key , InputError::Action action) {
         if (hasKey(key))
-            m_errorContexts[key] = action;
+            setAction( key , action );
         else
             throw std::invalid_argument("The errormode key: " + key + " has not been registered");
     }
@@ -18,8 +18,12 @@
  */
 
 #include <cctype>
+#include <chrono>
 #include <fstream>
 #include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -38,11 +42,13 @@
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+#include <opm/parser/eclipse/Parser/ParserStatistics.hpp>
 #include <opm/parser/eclipse/RawDeck/RawConsts.hpp>
 #include <opm/parser/eclipse/RawDeck/RawEnums.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 
 namespace Opm {
@@ -177,6 +183,29 @@ inline std::string clean( const std::string& str ) {
 
 const std::string emptystr = "";
 
+using stats_clock = std::chrono::steady_clock;
+
+inline double seconds_since( stats_clock::time_point start ) {
+    return std::chrono::duration< double >( stats_clock::now() - start ).count();
+}
+
+size_t raw_size( const RawKeyword& keyword ) {
+    size_t bytes = 0;
+    for( const auto& record : keyword )
+        bytes += record.getRecordString().size();
+
+    return bytes;
+}
+
+size_t value_count( const DeckKeyword& keyword ) {
+    size_t values = 0;
+    for( const auto& record : keyword )
+        for( const auto& item : record )
+            values += item.size();
+
+    return values;
+}
+
 struct file {
     file( boost::filesystem::path p, const std::string& in ) :
         input( in ), path( p )
@@ -185,6 +214,7 @@ struct file {
     string_view input;
     size_t lineNR = 0;
     boost::filesystem::path path;
+    size_t stats_index = ParserStatistics::root;
 };
 
 class InputStack : public std::stack< file, std::vector< file > > {
@@ -203,8 +233,8 @@ void InputStack::push( std::string&& input, boost::filesystem::path p ) {
 
 class ParserState {
     public:
-        ParserState( const ParseContext& );
-        ParserState( const ParseContext&, boost::filesystem::path );
+        ParserState( const ParseContext&, std::shared_ptr< ParserStatistics > );
+        ParserState( const ParseContext&, boost::filesystem::path, std::shared_ptr< ParserStatistics > );
 
         void loadString( const std::string& );
         void loadFile( const boost::filesystem::path& );
@@ -221,11 +251,19 @@ class ParserState {
         string_view getline();
         void closeFile();
 
+        /*
+          The timer is only started when collecting statistics, so the
+          timing calls cost nothing for a normal parse.
+        */
+        stats_clock::time_point startTimer() const;
+        void recordKeyword( const DeckKeyword&, size_t bytes, double seconds );
+
     private:
         InputStack input_stack;
 
         std::map< std::string, std::string > pathMap;
         boost::filesystem::path rootPath;
+        std::map< std::string, size_t > statsFileIndex;
 
     public:
         std::shared_ptr< RawKeyword > rawKeyword;
@@ -233,6 +271,7 @@ class ParserState {
         Deck deck;
         const ParseContext& parseContext;
         bool unknown_keyword = false;
+        std::shared_ptr< ParserStatistics > statistics;
 };
 
 
@@ -266,20 +305,44 @@ void ParserState::closeFile() {
     this->input_stack.pop();
 }
 
-ParserState::ParserState(const ParseContext& __parseContext) :
-    parseContext( __parseContext )
+stats_clock::time_point ParserState::startTimer() const {
+    if( !this->statistics ) return {};
+    return stats_clock::now();
+}
+
+void ParserState::recordKeyword( const DeckKeyword& keyword, size_t bytes, double seconds ) {
+    this->statistics->add( ParserStatistics::phase::keyword_parse, seconds, bytes );
+    this->statistics->addKeyword( keyword.name(), bytes, value_count( keyword ), seconds );
+
+    const auto file_index = this->statsFileIndex.find( keyword.getFileName() );
+    if( file_index != this->statsFileIndex.end() )
+        this->statistics->getFile( file_index->second ).parse_seconds += seconds;
+}
+
+ParserState::ParserState(const ParseContext& __parseContext,
+                         std::shared_ptr< ParserStatistics > stats ) :
+    parseContext( __parseContext ),
+    statistics( std::move( stats ) )
 {}
 
 ParserState::ParserState( const ParseContext& context,
-                          boost::filesystem::path p ) :
+                          boost::filesystem::path p,
+                          std::shared_ptr< ParserStatistics > stats ) :
     rootPath( boost::filesystem::canonical( p ).parent_path() ),
-    parseContext( context )
+    parseContext( context ),
+    statistics( std::move( stats ) )
 {
     openRootFile( p );
 }
 
 void ParserState::loadString(const std::string& input) {
-    this->input_stack.push( clean( input + "\n" ) );
+    const auto start = this->startTimer();
+    auto cleaned = clean( input + "\n" );
+
+    if( this->statistics )
+        this->statistics->add( ParserStatistics::phase::clean, seconds_since( start ), input.size() );
+
+    this->input_stack.push( std::move( cleaned ) );
 }
 
 void ParserState::loadFile(const boost::filesystem::path& inputFile) {
@@ -289,7 +352,7 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
         inputFileCanonical = boost::filesystem::canonical(inputFile);
     } catch (boost::filesystem::filesystem_error fs_error) {
         std::string msg = "Could not open file: " + inputFile.string();
-        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
+        parseContext.handleError( ParseContext::ErrorKey::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
         return;
     }
 
@@ -302,7 +365,7 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
     // make sure the file we'd like to parse is readable
     if( !ufp ) {
         std::string msg = "Could not read from file: " + inputFile.string();
-        parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
+        parseContext.handleError( ParseContext::ErrorKey::PARSE_MISSING_INCLUDE , deck.getMessageContainer() , msg);
         return;
     }
 
@@ -311,6 +374,7 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
      * reasons, as streams are slow
      */
 
+    auto start = this->startTimer();
     auto* fp = ufp.get();
     std::string buffer;
     std::fseek( fp, 0, SEEK_END );
@@ -323,7 +387,29 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
         throw std::runtime_error( "Error when reading input file '"
                                 + inputFileCanonical.string() + "'" );
 
-    this->input_stack.push( clean( buffer ), inputFileCanonical );
+    if( !this->statistics ) {
+        this->input_stack.push( clean( buffer ), inputFileCanonical );
+        return;
+    }
+
+    const double io_seconds = seconds_since( start );
+    start = stats_clock::now();
+    auto cleaned = clean( buffer );
+    const double clean_seconds = seconds_since( start );
+
+    this->statistics->add( ParserStatistics::phase::file_io, io_seconds, buffer.size() );
+    this->statistics->add( ParserStatistics::phase::clean, clean_seconds, buffer.size() );
+
+    const auto parent = this->input_stack.empty() ? ParserStatistics::root
+                                                  : this->input_stack.top().stats_index;
+    const auto index = this->statistics->addFile( inputFileCanonical.string(), parent );
+    auto& file_stats = this->statistics->getFile( index );
+    file_stats.bytes = buffer.size();
+    file_stats.read_seconds = io_seconds + clean_seconds;
+    this->statsFileIndex[ inputFileCanonical.string() ] = index;
+
+    this->input_stack.push( std::move( cleaned ), inputFileCanonical );
+    this->input_stack.top().stats_index = index;
 }
 
 /*
@@ -333,23 +419,21 @@ void ParserState::loadFile(const boost::filesystem::path& inputFile) {
  */
 
 void ParserState::handleRandomText(const string_view& keywordString ) const {
-    std::string errorKey;
-    std::stringstream msg;
-    std::string trimmedCopy = keywordString.string();
-
-    if (trimmedCopy == "/") {
-        errorKey = ParseContext::PARSE_RANDOM_SLASH;
-        msg << "Extra '/' detected at: "
-            << this->current_path()
-            << ":" << this->line();
-    } else {
-        errorKey = ParseContext::PARSE_RANDOM_TEXT;
-        msg << "String \'" << keywordString
-            << "\' not formatted/recognized as valid keyword at: "
-            << this->current_path()
-            << ":" << this->line();
-    }
-    parseContext.handleError( errorKey , deck.getMessageContainer() , msg.str() );
+    const bool randomSlash = keywordString == "/";
+    const auto errorKey = randomSlash ? ParseContext::ErrorKey::PARSE_RANDOM_SLASH
+                                      : ParseContext::ErrorKey::PARSE_RANDOM_TEXT;
+
+    parseContext.handleError( errorKey , deck.getMessageContainer() , [&]() {
+        std::stringstream msg;
+        if (randomSlash)
+            msg << "Extra '/' detected at: ";
+        else
+            msg << "String \'" << keywordString
+                << "\' not formatted/recognized as valid keyword at: ";
+
+        msg << this->current_path() << ":" << this->line();
+        return msg.str();
+    });
 }
 
 void ParserState::openRootFile( const boost::filesystem::path& inputFile) {
@@ -397,9 +481,10 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
 
     if( !parser.isRecognizedKeyword( keywordString ) ) {
         if( ParserKeyword::validDeckName( keywordString ) ) {
-            std::string msg = "Keyword " + keywordString + " not recognized.";
             auto& msgContainer = parserState.deck.getMessageContainer();
-            parserState.parseContext.handleError( ParseContext::PARSE_UNKNOWN_KEYWORD, msgContainer, msg );
+            parserState.parseContext.handleError( ParseContext::ErrorKey::PARSE_UNKNOWN_KEYWORD, msgContainer, [&keywordString]() {
+                return "Keyword " + keywordString + " not recognized.";
+            });
             parserState.unknown_keyword = true;
             return {};
         }
@@ -447,10 +532,11 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
                                                 parserKeyword->isTableCollection() );
     }
 
-    std::string msg = "Expected the kewyord: " +keyword_size.keyword 
-                    + " to infer the number of records in: " + keywordString;
     auto& msgContainer = parserState.deck.getMessageContainer();
-    parserState.parseContext.handleError(ParseContext::PARSE_MISSING_DIMS_KEYWORD , msgContainer, msg );
+    parserState.parseContext.handleError(ParseContext::ErrorKey::PARSE_MISSING_DIMS_KEYWORD , msgContainer, [&]() {
+        return "Expected the kewyord: " + keyword_size.keyword
+             + " to infer the number of records in: " + keywordString;
+    });
 
     const auto* keyword = parser.getKeyword( keyword_size.keyword );
     const auto& record = keyword->getRecord(0);
@@ -523,7 +609,16 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
 
         parserState.rawKeyword.reset();
 
+        const auto raw_start = parserState.startTimer();
         const bool streamOK = tryParseKeyword( parserState, parser );
+
+        size_t raw_bytes = 0;
+        if( parserState.statistics ) {
+            const double raw_seconds = seconds_since( raw_start );
+            if( parserState.rawKeyword ) raw_bytes = raw_size( *parserState.rawKeyword );
+            parserState.statistics->add( ParserStatistics::phase::raw_split, raw_seconds, raw_bytes );
+        }
+
         if( !parserState.rawKeyword && !streamOK )
             continue;
 
@@ -557,7 +652,13 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         if( parser.isRecognizedKeyword( parserState.rawKeyword->getKeywordName() ) ) {
             const auto& kwname = parserState.rawKeyword->getKeywordName();
             const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
-            parserState.deck.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword ) );
+
+            const auto start = parserState.startTimer();
+            auto deckKeyword = parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword );
+            if( parserState.statistics )
+                parserState.recordKeyword( deckKeyword, raw_bytes, seconds_since( start ) );
+
+            parserState.deck.addKeyword( std::move( deckKeyword ) );
         } else {
             DeckKeyword deckKeyword( parserState.rawKeyword->getKeywordName(), false );
             const std::string msg = "The keyword " + parserState.rawKeyword->getKeywordName() + " is not recognized";
@@ -572,6 +673,26 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     return true;
 }
 
+void applyUnits( ParserState& parserState, const Parser& parser ) {
+    const auto start = parserState.startTimer();
+    parser.applyUnitsToDeck( parserState.deck );
+
+    if( parserState.statistics )
+        parserState.statistics->add( ParserStatistics::phase::units, seconds_since( start ) );
+}
+
+std::shared_ptr< ParserStatistics > newStatistics( bool enabled ) {
+    if( !enabled ) return {};
+    return std::make_shared< ParserStatistics >();
+}
+
+void finishStatistics( ParserState& parserState, stats_clock::time_point start ) {
+    if( !parserState.statistics ) return;
+
+    parserState.statistics->setTotal( seconds_since( start ) );
+    parserState.deck.setParserStatistics( parserState.statistics );
+}
+
 }
 
 
@@ -642,23 +763,31 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext) const {
-        ParserState parserState( parseContext, dataFileName );
+        const auto start = stats_clock::now();
+        ParserState parserState( parseContext, dataFileName, newStatistics( this->m_collectStatistics ) );
         parseState( parserState, *this );
-        applyUnitsToDeck( parserState.deck );
+        applyUnits( parserState, *this );
+        finishStatistics( parserState, start );
 
         return std::move( parserState.deck );
     }
 
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext) const {
-        ParserState parserState( parseContext );
+        const auto start = stats_clock::now();
+        ParserState parserState( parseContext, newStatistics( this->m_collectStatistics ) );
         parserState.loadString( data );
 
         parseState( parserState, *this );
-        applyUnitsToDeck( parserState.deck );
+        applyUnits( parserState, *this );
+        finishStatistics( parserState, start );
 
         return std::move( parserState.deck );
     }
 
+    void Parser::enableStatistics( bool enable ) {
+        this->m_collectStatistics = enable;
+    }
+
     size_t Parser::size() const {
         return m_deckParserKeywords.size();
     }
@@ -816,15 +945,52 @@ std::vector<std::string> Parser::getAllDeckNames () const {
         if( deck.hasKeyword( "METRIC" ) )
             deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
 
+        auto& activeSystem = deck.getActiveUnitSystem();
+        auto& defaultSystem = deck.getDefaultUnitSystem();
+
+        /*
+         * The keywords are processed in two passes. The first, serial, pass
+         * collects the keywords with dimensions and makes sure all the
+         * dimension strings they use are parsed and registered in the unit
+         * systems - UnitSystem::getNewDimension() modifies the unit system
+         * the first time a dimension is seen. After that the unit systems
+         * are only read, and every keyword can be processed independently.
+         *
+         * The ParserKeyword cached on the deck keywords is cleared in the
+         * first pass; the deck may outlive the parser which owns it.
+         */
+        std::vector< std::pair< const ParserKeyword*, DeckKeyword* > > keywords;
+        std::set< const ParserKeyword* > resolved;
+
         for( auto& deckKeyword : deck ) {
+            const auto* parserKeyword = deckKeyword.getParserKeyword();
+            deckKeyword.setParserKeyword( nullptr );
 
-            if( !isRecognizedKeyword( deckKeyword.name() ) ) continue;
+            if( !parserKeyword ) {
+                if( !isRecognizedKeyword( deckKeyword.name() ) ) continue;
+                parserKeyword = getParserKeywordFromDeckName( deckKeyword.name() );
+            }
 
-            const auto* parserKeyword = getParserKeywordFromDeckName( deckKeyword.name() );
             if( !parserKeyword->hasDimension() ) continue;
 
-            parserKeyword->applyUnitsToDeck(deck , deckKeyword);
+            if( resolved.insert( parserKeyword ).second ) {
+                for( const auto& record : *parserKeyword ) {
+                    for( const auto& item : record ) {
+                        for( size_t idim = 0; idim < item.numDimensions(); idim++ ) {
+                            activeSystem.getNewDimension( item.getDimension( idim ) );
+                            defaultSystem.getNewDimension( item.getDimension( idim ) );
+                        }
+                    }
+                }
+            }
+
+            keywords.emplace_back( parserKeyword, &deckKeyword );
         }
+
+        parallel::for_each( keywords.size(), [&]( size_t index ) {
+            const auto& kw = keywords[ index ];
+            kw.first->applyUnitsToDeck( deck, *kw.second );
+        }, 64 );
     }
 
     static bool isSectionDelimiter( const DeckKeyword& keyword ) {
@@ -484,6 +484,7 @@ void set_dimensions( ParserItem& item,
         DeckKeyword keyword( rawKeyword->getKeywordName() );
         keyword.setLocation( rawKeyword->getFilename(), rawKeyword->getLineNR() );
         keyword.setDataKeyword( isDataKeyword() );
+        keyword.setParserKeyword( this );
 
         size_t record_nr = 0;
         for( auto& rawRecord : *rawKeyword ) {
@@ -89,10 +89,18 @@ namespace {
 
 
     void ParserRecord::applyUnitsToDeck( Deck& deck, DeckRecord& deckRecord ) const {
-        for( const auto& item : *this ) {
+        for( size_t index = 0; index < this->m_items.size(); index++ ) {
+            const auto& item = this->m_items[ index ];
             if( !item.hasDimension() ) continue;
 
-            auto& deckItem = deckRecord.getItem( item.name() );
+            /*
+              The DeckRecord is created by parse() with the items in the
+              same order as the ParserRecord; the lookup by name is only
+              a fallback.
+            */
+            auto& deckItem = ( index < deckRecord.size() && deckRecord.getItem( index ).name() == item.name() )
+                           ? deckRecord.getItem( index )
+                           : deckRecord.getItem( item.name() );
 
             for (size_t idim = 0; idim < item.numDimensions(); idim++) {
                 auto activeDimension  = deck.getActiveUnitSystem().getNewDimension( item.getDimension(idim) );
@@ -131,10 +139,11 @@ namespace {
             items.emplace_back( parserItem.scan( rawRecord ) );
 
         if (rawRecord.size() > 0) {
-            std::string msg = "The RawRecord for keyword \""  + rawRecord.getKeywordName() + "\" in file\"" + rawRecord.getFileName() + "\" contained " +
-                std::to_string(rawRecord.size()) +
-                " too many items according to the spec. RawRecord was: " + rawRecord.getRecordString();
-            parseContext.handleError(ParseContext::PARSE_EXTRA_DATA , msgContainer, msg);
+            parseContext.handleError(ParseContext::ErrorKey::PARSE_EXTRA_DATA , msgContainer, [&rawRecord]() {
+                return "The RawRecord for keyword \""  + rawRecord.getKeywordName() + "\" in file\"" + rawRecord.getFileName() + "\" contained " +
+                    std::to_string(rawRecord.size()) +
+                    " too many items according to the spec. RawRecord was: " + rawRecord.getRecordString();
+            });
         }
 
         return { std::move( items ) };
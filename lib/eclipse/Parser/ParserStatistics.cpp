@@ -0,0 +1,237 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Parser/ParserStatistics.hpp>
+
+namespace Opm {
+
+    const size_t ParserStatistics::root = std::numeric_limits< size_t >::max();
+
+namespace {
+
+    size_t index( ParserStatistics::phase p ) {
+        return static_cast< size_t >( p );
+    }
+
+    std::string json_string( const std::string& str ) {
+        std::string quoted = "\"";
+        for( const auto c : str ) {
+            if( c == '"' || c == '\\' ) quoted += '\\';
+            quoted += c;
+        }
+
+        return quoted + "\"";
+    }
+
+    double mb_per_second( size_t bytes, double seconds ) {
+        if( seconds <= 0 ) return 0;
+        return bytes / ( 1024.0 * 1024.0 ) / seconds;
+    }
+
+}
+
+    void ParserStatistics::add( phase p, double seconds, size_t bytes ) {
+        auto& t = this->m_phases.at( index( p ) );
+        t.count++;
+        t.bytes += bytes;
+        t.seconds += seconds;
+    }
+
+    void ParserStatistics::addKeyword( const std::string& name,
+                                       size_t bytes,
+                                       size_t values,
+                                       double seconds ) {
+        auto& kw = this->m_keywords[ name ];
+        kw.count++;
+        kw.bytes += bytes;
+        kw.values += values;
+        kw.seconds += seconds;
+    }
+
+    size_t ParserStatistics::addFile( const std::string& path, size_t parent ) {
+        if( parent != root && parent >= this->m_files.size() )
+            throw std::invalid_argument( "Invalid parent file index" );
+
+        file_statistics file;
+        file.path = path;
+        file.parent = parent;
+        file.depth = parent == root ? 0 : this->m_files[ parent ].depth + 1;
+
+        this->m_files.push_back( file );
+        return this->m_files.size() - 1;
+    }
+
+    ParserStatistics::file_statistics& ParserStatistics::getFile( size_t file_index ) {
+        return this->m_files.at( file_index );
+    }
+
+    void ParserStatistics::setTotal( double seconds ) {
+        this->m_total = seconds;
+    }
+
+    const ParserStatistics::timing& ParserStatistics::get( phase p ) const {
+        return this->m_phases.at( index( p ) );
+    }
+
+    const std::map< std::string, ParserStatistics::keyword_statistics >&
+    ParserStatistics::keywords() const {
+        return this->m_keywords;
+    }
+
+    const std::vector< ParserStatistics::file_statistics >&
+    ParserStatistics::files() const {
+        return this->m_files;
+    }
+
+    double ParserStatistics::total() const {
+        return this->m_total;
+    }
+
+    const std::string& ParserStatistics::phaseName( phase p ) {
+        static const std::string names[] = {
+            "file_io", "clean", "raw_split", "keyword_parse", "units"
+        };
+
+        return names[ index( p ) ];
+    }
+
+
+    void ParserStatistics::writeTable( std::ostream& stream ) const {
+        const auto flags = stream.flags();
+        const auto precision = stream.precision();
+        stream << std::fixed;
+
+        stream << "Parser statistics - total time: "
+               << std::setprecision( 3 ) << this->m_total << " s\n\n";
+
+        stream << std::left << std::setw( 16 ) << "Phase"
+               << std::right << std::setw( 10 ) << "Count"
+               << std::setw( 14 ) << "Bytes"
+               << std::setw( 12 ) << "Time [s]"
+               << std::setw( 10 ) << "MB/s" << "\n";
+
+        for( size_t p = 0; p < this->m_phases.size(); ++p ) {
+            const auto& t = this->m_phases[ p ];
+            stream << std::left << std::setw( 16 ) << phaseName( phase( p ) )
+                   << std::right << std::setw( 10 ) << t.count
+                   << std::setw( 14 ) << t.bytes
+                   << std::setw( 12 ) << std::setprecision( 4 ) << t.seconds
+                   << std::setw( 10 ) << std::setprecision( 1 )
+                   << mb_per_second( t.bytes, t.seconds ) << "\n";
+        }
+
+        /* the keywords are listed with the most expensive keywords first */
+        std::vector< std::pair< std::string, keyword_statistics > > keywords(
+                this->m_keywords.begin(), this->m_keywords.end() );
+
+        std::stable_sort( keywords.begin(), keywords.end(),
+                []( const std::pair< std::string, keyword_statistics >& lhs,
+                    const std::pair< std::string, keyword_statistics >& rhs ) {
+                    return lhs.second.seconds > rhs.second.seconds;
+                } );
+
+        stream << "\n" << std::left << std::setw( 16 ) << "Keyword"
+               << std::right << std::setw( 10 ) << "Count"
+               << std::setw( 14 ) << "Bytes"
+               << std::setw( 14 ) << "Values"
+               << std::setw( 12 ) << "Time [s]" << "\n";
+
+        for( const auto& kw : keywords ) {
+            stream << std::left << std::setw( 16 ) << kw.first
+                   << std::right << std::setw( 10 ) << kw.second.count
+                   << std::setw( 14 ) << kw.second.bytes
+                   << std::setw( 14 ) << kw.second.values
+                   << std::setw( 12 ) << std::setprecision( 4 ) << kw.second.seconds
+                   << "\n";
+        }
+
+        stream << "\n" << std::left << std::setw( 50 ) << "File"
+               << std::right << std::setw( 14 ) << "Bytes"
+               << std::setw( 12 ) << "Read [s]"
+               << std::setw( 12 ) << "Parse [s]" << "\n";
+
+        for( const auto& file : this->m_files ) {
+            stream << std::left << std::setw( 50 )
+                   << ( std::string( 2 * file.depth, ' ' ) + file.path )
+                   << std::right << std::setw( 14 ) << file.bytes
+                   << std::setw( 12 ) << std::setprecision( 4 ) << file.read_seconds
+                   << std::setw( 12 ) << file.parse_seconds << "\n";
+        }
+
+        stream.flags( flags );
+        stream.precision( precision );
+    }
+
+
+    void ParserStatistics::writeJSON( std::ostream& stream ) const {
+        const auto precision = stream.precision();
+        stream << std::setprecision( 9 );
+
+        stream << "{\n  \"total_seconds\": " << this->m_total << ",\n";
+
+        stream << "  \"phases\": {";
+        for( size_t p = 0; p < this->m_phases.size(); ++p ) {
+            const auto& t = this->m_phases[ p ];
+            stream << ( p == 0 ? "\n" : ",\n" )
+                   << "    " << json_string( phaseName( phase( p ) ) ) << ": { "
+                   << "\"count\": " << t.count << ", "
+                   << "\"bytes\": " << t.bytes << ", "
+                   << "\"seconds\": " << t.seconds << " }";
+        }
+        stream << "\n  },\n";
+
+        stream << "  \"keywords\": {";
+        bool first = true;
+        for( const auto& kw : this->m_keywords ) {
+            stream << ( first ? "\n" : ",\n" )
+                   << "    " << json_string( kw.first ) << ": { "
+                   << "\"count\": " << kw.second.count << ", "
+                   << "\"bytes\": " << kw.second.bytes << ", "
+                   << "\"values\": " << kw.second.values << ", "
+                   << "\"seconds\": " << kw.second.seconds << " }";
+            first = false;
+        }
+        stream << "\n  },\n";
+
+        stream << "  \"files\": [";
+        for( size_t i = 0; i < this->m_files.size(); ++i ) {
+            const auto& file = this->m_files[ i ];
+            stream << ( i == 0 ? "\n" : ",\n" )
+                   << "    { \"path\": " << json_string( file.path ) << ", "
+                   << "\"parent\": ";
+
+            if( file.parent == root ) stream << "null";
+            else                      stream << file.parent;
+
+            stream << ", \"bytes\": " << file.bytes << ", "
+                   << "\"read_seconds\": " << file.read_seconds << ", "
+                   << "\"parse_seconds\": " << file.parse_seconds << " }";
+        }
+        stream << "\n  ]\n}\n";
+
+        stream.precision( precision );
+    }
+
+}
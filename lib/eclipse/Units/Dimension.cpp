@@ -63,6 +63,44 @@ namespace Opm {
         return (siValue - m_SIoffset)/m_SIfactor;
     }
 
+    /*
+      The bulk conversions check the factor once, and then run plain
+      scale + offset loops which the compiler will vectorize for the
+      common stride == 1 case. The offset is only non-zero for the
+      temperature dimensions, so the pure scaling is kept as a separate
+      loop.
+    */
+    void Dimension::convertRawToSi(const double* raw, double* si, size_t size, size_t stride) const {
+        const double factor = this->getSIScaling();
+        const double offset = this->m_SIoffset;
+
+        if (stride == 1) {
+            if (offset == 0.0) {
+                for (size_t index = 0; index < size; index++)
+                    si[index] = raw[index] * factor;
+            } else {
+                for (size_t index = 0; index < size; index++)
+                    si[index] = raw[index] * factor + offset;
+            }
+        } else {
+            for (size_t index = 0; index < size; index += stride)
+                si[index] = raw[index] * factor + offset;
+        }
+    }
+
+    void Dimension::convertSiToRaw(const double* si, double* raw, size_t size, size_t stride) const {
+        const double factor = this->getSIScaling();
+        const double offset = this->m_SIoffset;
+
+        if (stride == 1) {
+            for (size_t index = 0; index < size; index++)
+                raw[index] = (si[index] - offset) / factor;
+        } else {
+            for (size_t index = 0; index < size; index += stride)
+                raw[index] = (si[index] - offset) / factor;
+        }
+    }
+
     const std::string& Dimension::getName() const {
         return m_name;
     }
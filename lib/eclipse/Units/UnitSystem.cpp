@@ -572,16 +572,31 @@ namespace {
     }
 
     void UnitSystem::from_si( measure m, std::vector<double>& data ) const {
-        double factor = this->measure_table_from_si[ static_cast< int >( m ) ];
-        auto scale = [=](double x) { return x * factor; };
-        std::transform( data.begin() , data.end() , data.begin() , scale);
+        this->from_si( m, data.data(), data.data(), data.size() );
     }
 
 
     void UnitSystem::to_si( measure m, std::vector<double>& data) const {
-        double factor = this->measure_table_to_si[ static_cast< int >( m ) ];
-        auto scale = [=](double x) { return x * factor; };
-        std::transform( data.begin() , data.end() , data.begin() , scale);
+        this->to_si( m, data.data(), data.data(), data.size() );
+    }
+
+
+    /*
+      The measures are all pure scalings, i.e. the bulk conversion is a
+      single multiplication per element; in and out are allowed to be
+      the same buffer.
+    */
+    void UnitSystem::from_si( measure m, const double* in, double* out, size_t size ) const {
+        const double factor = this->measure_table_from_si[ static_cast< int >( m ) ];
+        for( size_t index = 0; index < size; index++ )
+            out[ index ] = in[ index ] * factor;
+    }
+
+
+    void UnitSystem::to_si( measure m, const double* in, double* out, size_t size ) const {
+        const double factor = this->measure_table_to_si[ static_cast< int >( m ) ];
+        for( size_t index = 0; index < size; index++ )
+            out[ index ] = in[ index ] * factor;
     }
 
 
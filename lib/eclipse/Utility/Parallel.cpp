@@ -0,0 +1,180 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <string>
+
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
+
+namespace Opm {
+namespace parallel {
+
+    size_t num_threads() {
+        static const size_t threads = []() -> size_t {
+            const char* env = std::getenv( "OPM_NUM_THREADS" );
+            if( env ) {
+                try {
+                    const long value = std::stol( env );
+                    if( value > 0 ) return size_t( value );
+                } catch( const std::exception& ) {}
+            }
+
+            const size_t hw = std::thread::hardware_concurrency();
+            return hw > 0 ? hw : 1;
+        }();
+
+        return threads;
+    }
+
+    namespace {
+        thread_local bool worker = false;
+    }
+
+    bool in_worker() {
+        return worker;
+    }
+
+    worker_scope::worker_scope() :
+        previous( worker )
+    {
+        worker = true;
+    }
+
+    worker_scope::~worker_scope() {
+        worker = this->previous;
+    }
+
+    void task_graph::add( std::function< void() > task,
+                          const std::vector< std::string >& resources ) {
+        const size_t index = this->tasks.size();
+        this->tasks.push_back( std::move( task ) );
+        this->dependents.emplace_back();
+        this->num_dependencies.push_back( 0 );
+
+        std::vector< size_t > before;
+        for( const auto& resource : resources ) {
+            auto iter = this->last_task.find( resource );
+            if( iter != this->last_task.end() ) {
+                before.push_back( iter->second );
+                iter->second = index;
+            } else
+                this->last_task.emplace( resource, index );
+        }
+
+        std::sort( before.begin(), before.end() );
+        before.erase( std::unique( before.begin(), before.end() ), before.end() );
+        for( size_t task_index : before )
+            this->dependents[ task_index ].push_back( index );
+
+        this->num_dependencies[ index ] = before.size();
+    }
+
+    size_t task_graph::size() const {
+        return this->tasks.size();
+    }
+
+    bool task_graph::empty() const {
+        return this->tasks.empty();
+    }
+
+    void task_graph::run() {
+        auto tasks = std::move( this->tasks );
+        auto dependents = std::move( this->dependents );
+        auto num_dependencies = std::move( this->num_dependencies );
+        this->tasks.clear();
+        this->dependents.clear();
+        this->num_dependencies.clear();
+        this->last_task.clear();
+
+        const size_t threads = std::min( num_threads(), tasks.size() );
+        if( threads <= 1 ) {
+            for( auto& task : tasks ) task();
+            return;
+        }
+
+        /*
+         * The ready tasks are started in insertion order; after a task has
+         * failed the later tasks are only marked as done.
+         */
+        const size_t none = std::numeric_limits< size_t >::max();
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque< size_t > ready;
+        size_t remaining = tasks.size();
+        size_t first_error = none;
+        std::exception_ptr error;
+
+        for( size_t index = 0; index < tasks.size(); ++index )
+            if( num_dependencies[ index ] == 0 ) ready.push_back( index );
+
+        const auto worker = [&]() {
+            std::unique_lock< std::mutex > lock( mutex );
+            while( true ) {
+                cv.wait( lock, [&] { return !ready.empty() || remaining == 0; } );
+                if( remaining == 0 ) return;
+
+                const auto iter = std::min_element( ready.begin(), ready.end() );
+                const size_t index = *iter;
+                ready.erase( iter );
+
+                std::exception_ptr task_error;
+                if( index < first_error ) {
+                    lock.unlock();
+                    worker_scope scope;
+                    try {
+                        tasks[ index ]();
+                    } catch( ... ) {
+                        task_error = std::current_exception();
+                    }
+                    lock.lock();
+                }
+
+                if( task_error && index < first_error ) {
+                    first_error = index;
+                    error = task_error;
+                }
+
+                for( size_t next : dependents[ index ] )
+                    if( --num_dependencies[ next ] == 0 ) ready.push_back( next );
+
+                --remaining;
+                cv.notify_all();
+            }
+        };
+
+        std::vector< std::thread > pool;
+        pool.reserve( threads - 1 );
+        for( size_t t = 1; t < threads; ++t )
+            pool.emplace_back( worker );
+
+        worker();
+
+        for( auto& thread : pool )
+            thread.join();
+
+        if( error ) std::rethrow_exception( error );
+    }
+
+}
+}
@@ -56,6 +56,7 @@ namespace Opm {
      * use-after-free.
      */
     class DeckOutput;
+    class ParserStatistics;
 
     class DeckView {
         public:
@@ -146,6 +147,13 @@ namespace Opm {
             const std::string getDataFile() const;
             void setDataFile(const std::string& dataFile);
 
+            /*
+              The statistics collected by the Parser when creating this
+              deck, or nullptr if the parser did not collect statistics.
+            */
+            std::shared_ptr< const ParserStatistics > getParserStatistics() const;
+            void setParserStatistics( std::shared_ptr< const ParserStatistics > statistics );
+
             iterator begin();
             iterator end();
             void write( DeckOutput& output ) const ;
@@ -159,6 +167,7 @@ namespace Opm {
             UnitSystem activeUnits;
 
             std::string m_dataFile;
+            std::shared_ptr< const ParserStatistics > m_statistics;
     };
 }
 #endif  /* DECK_HPP */
@@ -52,6 +52,16 @@ namespace Opm {
         bool isKnown() const;
         bool isDataKeyword() const;
 
+        /*
+          The ParserKeyword which created this keyword, set by
+          ParserKeyword::parse() so the post processing of the deck does
+          not need to look the keyword up by name again. It is not owned
+          by the keyword, and the Parser clears it before the deck is
+          returned; the keywords of a parsed deck return nullptr.
+        */
+        void setParserKeyword(const ParserKeyword* parserKeyword);
+        const ParserKeyword* getParserKeyword() const;
+
         const std::vector<int>& getIntData() const;
         const std::vector<double>& getRawDoubleData() const;
         const std::vector<double>& getSIDoubleData() const;
@@ -86,6 +96,7 @@ namespace Opm {
         bool m_knownKeyword;
         bool m_isDataKeyword;
         bool m_slashTerminated;
+        const ParserKeyword* m_parserKeyword;
     };
 }
 
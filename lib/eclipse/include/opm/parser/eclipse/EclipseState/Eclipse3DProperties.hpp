@@ -19,6 +19,7 @@
 #ifndef OPM_ECLIPSE_PROPERTIES_HPP
 #define OPM_ECLIPSE_PROPERTIES_HPP
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -39,6 +40,7 @@ namespace Opm {
     class DeckKeyword;
     class DeckRecord;
     class EclipseGrid;
+    class RegionIndex;
     class Section;
     class TableManager;
     class UnitSystem;
@@ -55,6 +57,13 @@ namespace Opm {
 
 
         std::vector< int > getRegions( const std::string& keyword ) const;
+
+        /*
+          The cells of every region of the region property keyword, e.g.
+          for aggregating per FIPNUM region. The index is built on first
+          use and kept until the property is modified.
+        */
+        std::shared_ptr< const RegionIndex > getRegionIndex( const std::string& keyword ) const;
         std::string getDefaultRegionKeyword() const;
 
         const GridProperty<int>&      getIntGridProperty     ( const std::string& keyword ) const;
@@ -68,6 +77,12 @@ namespace Opm {
         bool supportsGridProperty(const std::string& keyword) const;
         MessageContainer getMessageContainer();
 
+        /*
+          Store the properties for the active cells only; should be
+          called when the ACTNUM of the grid is final.
+        */
+        void compressToActive( const EclipseGrid& grid );
+
     private:
         const GridProperty<int>& getRegion(const DeckItem& regionItem) const;
         void processGridProperties(const Deck& deck,
@@ -76,23 +91,31 @@ namespace Opm {
         void scanSection(const Section& section,
                          const EclipseGrid& eclipseGrid);
 
-        void handleADDKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager);
         void handleBOXKeyword(     const DeckKeyword& deckKeyword, BoxManager& boxManager);
-        void handleCOPYKeyword(    const DeckKeyword& deckKeyword, BoxManager& boxManager);
         void handleENDBOXKeyword(  BoxManager& boxManager);
-        void handleEQUALSKeyword(  const DeckKeyword& deckKeyword, BoxManager& boxManager);
-        void handleMULTIPLYKeyword(const DeckKeyword& deckKeyword, BoxManager& boxManager);
 
-        void handleADDREGKeyword(  const DeckKeyword& deckKeyword );
-        void handleCOPYREGKeyword( const DeckKeyword& deckKeyword );
-        void handleEQUALREGKeyword(const DeckKeyword& deckKeyword );
-        void handleMULTIREGKeyword(const DeckKeyword& deckKeyword );
-        void handleOPERATEKeyword( const DeckKeyword& deckKeyword, BoxManager& boxManager);
+        void handleRecord(const std::string& keyword, const DeckRecord& record, BoxManager& boxManager);
+        bool planRecord(const std::string& keyword, const DeckRecord& record,
+                        BoxManager& boxManager, std::vector< std::string >& properties);
+
+        void handleADDRecord(      const DeckRecord& record, BoxManager& boxManager);
+        void handleCOPYRecord(     const DeckRecord& record, BoxManager& boxManager);
+        void handleEQUALSRecord(   const DeckRecord& record, BoxManager& boxManager);
+        void handleMULTIPLYRecord( const DeckRecord& record, BoxManager& boxManager);
+
+        void handleADDREGRecord(   const DeckRecord& record );
+        void handleCOPYREGRecord(  const DeckRecord& record );
+        void handleEQUALREGRecord( const DeckRecord& record );
+        void handleMULTIREGRecord( const DeckRecord& record );
+        void handleOPERATERecord(  const DeckRecord& record, BoxManager& boxManager);
 
         void loadGridPropertyFromDeckKeyword(const Box& inputBox,
                                              const DeckKeyword& deckKeyword);
 
-        void setKeywordBox(const DeckKeyword& deckKeyword, const DeckRecord&, BoxManager& boxManager);
+        bool addConstantProperty(const std::string& keyword);
+        bool hasRegion(const DeckItem& regionItem) const;
+        std::string getRegionName(const DeckItem& regionItem) const;
+        bool setKeywordBox(const DeckRecord&, BoxManager& boxManager) const;
 
         std::string            m_defaultRegion;
         UnitSystem             m_deckUnitSystem;
@@ -65,7 +65,19 @@ namespace Opm {
             AllProperties = IntProperties | DoubleProperties
         };
 
-        EclipseState(const Deck& deck , ParseContext parseContext = ParseContext());
+        /*
+          With PropertyStorage::ActiveCells the 3D properties are stored
+          for the active cells only, once ACTNUM is final. The input
+          values of the inactive cells are then lost: they read back as
+          the default value of the keyword, e.g. NaN for PORO, or zero
+          for keywords which are computed by an initializer, e.g. TEMPI.
+          The full size arrays are still available with getData(), which
+          permanently expands the property to all cells again.
+        */
+        enum class PropertyStorage { AllCells, ActiveCells };
+
+        EclipseState(const Deck& deck , ParseContext parseContext = ParseContext(),
+                     PropertyStorage propertyStorage = PropertyStorage::AllCells);
 
         const ParseContext& getParseContext() const;
         const IOConfig& getIOConfig() const;
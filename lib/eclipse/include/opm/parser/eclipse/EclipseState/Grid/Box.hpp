@@ -21,35 +21,83 @@
 #ifndef BOX_HPP_
 #define BOX_HPP_
 
-#include <vector>
 #include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
 
 namespace Opm {
 
+    /*
+      A Box is an IJK sub box of the global grid. The global indices of
+      the cells in the box are generated on the fly, in I-fastest
+      order, when iterating over the box; use forEachRange() to visit
+      them as contiguous ranges instead.
+    */
     class Box {
     public:
+        class const_iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef size_t value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const size_t* pointer;
+            typedef size_t reference;
+
+            const_iterator() = default;
+            const_iterator( const Box* box, size_t pos );
+
+            size_t operator*() const { return m_global; }
+            const_iterator& operator++();
+            const_iterator operator++( int );
+            bool operator==( const const_iterator& other ) const { return m_pos == other.m_pos; }
+            bool operator!=( const const_iterator& other ) const { return m_pos != other.m_pos; }
+
+        private:
+            const Box* m_box = nullptr;
+            size_t m_pos = 0;
+            size_t m_i = 0, m_j = 0, m_k = 0;
+            size_t m_global = 0;
+        };
+
         Box() = default;
         Box(int nx , int ny , int nz);
         Box(const Box& globalBox , int i1 , int i2 , int j1 , int j2 , int k1 , int k2); // Zero offset coordinates.
         size_t size() const;
         bool   isGlobal() const;
         size_t getDim(size_t idim) const;
-        const std::vector<size_t>& getIndexList() const;
+        size_t getOffset(size_t idim) const;
         bool equal(const Box& other) const;
 
+        /*
+          The global indices of the cells in the box. The list is
+          allocated on the first call; prefer iterating over the box,
+          or forEachRange().
+        */
+        const std::vector<size_t>& getIndexList() const;
+
+        /*
+          Will call f( begin, end ) for the ranges [begin,end) of
+          contiguous global indices in the box, in increasing order.
+          This is one range for each I-row of the box, rows which are
+          adjacent in the global grid are merged; for a global box it
+          is one range for the whole grid.
+        */
+        void forEachRange( const std::function< void( size_t, size_t ) >& f ) const;
+
         explicit operator bool() const;
-        std::vector<size_t>::const_iterator begin() const;
-        std::vector<size_t>::const_iterator end() const;
+        const_iterator begin() const;
+        const_iterator end() const;
 
     private:
-        void initIndexList();
+        size_t globalIndex( size_t i, size_t j, size_t k ) const;
         static void assertDims(const Box& globalBox, size_t idim , int l1 , int l2);
         size_t m_dims[3] = { 0, 0, 0 };
-        size_t m_offset[3];
-        size_t m_stride[3];
+        size_t m_offset[3] = { 0, 0, 0 };
+        size_t m_stride[3] = { 1, 0, 0 };
 
-        bool   m_isGlobal;
-        std::vector<size_t> m_indexList;
+        bool   m_isGlobal = false;
+        mutable std::vector<size_t> m_indexList;
     };
 }
 
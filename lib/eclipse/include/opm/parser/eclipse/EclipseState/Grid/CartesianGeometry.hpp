@@ -0,0 +1,106 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CARTESIAN_GEOMETRY_HPP
+#define OPM_CARTESIAN_GEOMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <ert/ecl/ecl_grid.h>
+
+namespace Opm {
+
+    /*
+      CartesianGeometry is the implicit geometry of a grid given with
+      the cartesian keywords, either DX/DY/DZ/TOPS per cell or
+      DXV/DYV/DZV per axis with DEPTHZ per pillar. All pillars are
+      vertical, and the corners of a cell are computed on demand from
+      the input spacings; the full corner point representation with
+      COORD and ZCORN is only created by the export methods, or when
+      an ERT grid is explicitly requested with allocGrid(). The cells
+      of a DTOPS grid are boxes which need not share corners with
+      their neighbours, so the exported COORD/ZCORN is then only an
+      approximation of the grid.
+
+      The corners are the same as in the ERT grids created with
+      ecl_grid_alloc_dx_dy_dz_tops() and
+      ecl_grid_alloc_dxv_dyv_dzv_depthz() respectively.
+    */
+
+    class CartesianGeometry {
+    public:
+        using corners = std::array< std::array< double, 3 >, 8 >;
+
+        static CartesianGeometry newDTOPS( size_t nx, size_t ny, size_t nz,
+                                           const std::vector< double >& dx,
+                                           const std::vector< double >& dy,
+                                           const std::vector< double >& dz,
+                                           const std::vector< double >& tops );
+
+        static CartesianGeometry newDVDEPTHZ( size_t nx, size_t ny, size_t nz,
+                                              const std::vector< double >& dxv,
+                                              const std::vector< double >& dyv,
+                                              const std::vector< double >& dzv,
+                                              const std::vector< double >& depthz );
+
+        /* The corners are numbered as in EclipseGrid::getCornerPos() */
+        corners getCorners( size_t i, size_t j, size_t k ) const;
+        corners getCorners( size_t globalIndex ) const;
+
+        void exportCOORD( std::vector< double >& coord ) const;
+        void exportZCORN( std::vector< double >& zcorn ) const;
+
+        /* Caller takes ownership of the returned grid. */
+        ecl_grid_type* allocGrid( const int* actnum ) const;
+
+    private:
+        enum class input { DTOPS, DVDEPTHZ };
+
+        CartesianGeometry( input, size_t nx, size_t ny, size_t nz );
+
+        double top( size_t i, size_t j, size_t k, size_t c ) const;
+        double bottom( size_t i, size_t j, size_t k, size_t c ) const;
+        size_t pillar( size_t i, size_t j, size_t c ) const;
+
+        input m_input;
+        size_t m_nx, m_ny, m_nz;
+
+        /* The x and y position of the pillars. */
+        std::vector< double > m_px;
+        std::vector< double > m_py;
+
+        /* DTOPS: the x and y position of the first corner of each cell. */
+        std::vector< double > m_x0;
+        std::vector< double > m_y0;
+
+        /* DTOPS: cell spacing and top, for DVDEPTHZ the spacings are
+           given per axis with one top depth per pillar. */
+        std::vector< double > m_dx;
+        std::vector< double > m_dy;
+        std::vector< double > m_dz;
+        std::vector< double > m_tops;
+
+        /* DVDEPTHZ: the depth of the top of layer k below DEPTHZ. */
+        std::vector< double > m_layers;
+    };
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CELL_LOCATOR_HPP
+#define OPM_CELL_LOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+
+namespace Opm {
+
+    /*
+      CellLocator finds the cell which contains a point. The search
+      structure has two levels:
+
+        1. The columns of cells are binned in a regular 2D bucket grid
+           covering the xy bounding box of the grid; every bucket
+           lists the columns whose xy bounding box overlaps it.
+
+        2. Along a column the cells are searched for with a binary
+           search on the depth ranges of the layers.
+
+      The candidate cells are checked exactly by splitting the cell in
+      six tetrahedra around the diagonal from corner 0 to corner 7;
+      the decomposition is consistent between neighbouring cells, so a
+      point belongs to exactly one cell except on the cell faces.
+    */
+
+    class CellLocator {
+    public:
+        CellLocator( size_t nx, size_t ny, size_t nz,
+                     const GridGeometry::corner_function& cell_corners );
+
+        /*
+          Will return the global index of the cell containing the
+          point (x,y,z), or -1 if the point is outside the grid.
+        */
+        int findCell( double x, double y, double z ) const;
+        std::vector< int > findCells( const std::vector< std::array< double, 3 > >& points ) const;
+
+    private:
+        bool contains( size_t i, size_t j, size_t k, double x, double y, double z ) const;
+        size_t bucket( size_t bi, size_t bj ) const;
+
+        size_t m_nx, m_ny, m_nz;
+        GridGeometry::corner_function m_corners;
+
+        /* xy bounding box of the columns: xmin, xmax, ymin, ymax */
+        std::vector< std::array< double, 4 > > m_column_box;
+
+        /*
+          For column c and layer k: the largest bottom depth of the
+          layers [0,k] and the smallest top depth of the layers
+          [k,nz). Both are monotone in k, and bound the layers which
+          can contain a given depth.
+        */
+        std::vector< double > m_max_bottom;
+        std::vector< double > m_min_top;
+
+        /* The bucket grid, with the column lists in CSR form. */
+        size_t m_bx, m_by;
+        double m_xmin, m_ymin, m_dx, m_dy;
+        std::vector< size_t > m_bucket_offset;
+        std::vector< size_t > m_bucket_columns;
+    };
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CONNECTION_GRAPH_HPP
+#define OPM_CONNECTION_GRAPH_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+    class EclipseGrid;
+    class NNC;
+    class TransMult;
+
+    /*
+      ConnectionGraph is the graph of connections between the active
+      cells of the grid, in compressed sparse row form indexed with
+      the active cell index. The connections of active cell a are the
+      entries [offsets()[a], offsets()[a+1]) of the per connection
+      arrays, and every connection is listed from both cells.
+
+      The graph contains:
+
+        1. The cartesian neighbours in the I, J and K directions.
+
+        2. With PINCH active, vertical connections over a run of
+           inactive cells with total thickness below the PINCH
+           threshold.
+
+        3. In corner point grids, the fault juxtapositions: across a
+           face in the I or J direction where the ZCORN values on the
+           two sides differ, every active cell in the neighbouring
+           column whose face overlaps the face of the cell. The
+           overlapping cell in the same layer is a cartesian
+           connection, the others are of type Fault. The block
+           centered grids from DX/DY/DZ/TOPS only have the cartesian
+           neighbours, and the faults are only used for MULTFLT.
+
+        4. The NNC entries from the deck between active cells.
+
+      The multiplier of a connection combines the MULTX/Y/Z and
+      MULTX-/Y-/Z- multipliers of the two cells, the MULTFLT fault
+      multipliers, which are folded into these by TransMult, and the
+      MULTREGT region multiplier. For a pinch connection the MULTZ
+      multiplier is taken from the top cell, or multiplied over all
+      the cells in the column with the PINCH option ALL.
+
+      The face is the FaceDir value of the face of the cell the
+      connection goes through, and zero for NNC connections; the NNC
+      connections have the multiplier of the MULTREGT records with
+      NNC behaviour NNC or ALL, and the input transmissibility from
+      nncTrans(), which is zero for the other connections.
+    */
+
+    class ConnectionGraph {
+    public:
+        enum class Type : char {
+            Cartesian,
+            Pinch,
+            Fault,
+            NNC
+        };
+
+        ConnectionGraph( const EclipseGrid& grid, const TransMult& transMult, const NNC& nnc );
+
+        size_t numCells() const;
+        size_t numConnections() const;
+
+        const std::vector< size_t >& offsets() const;
+        /* The active index of the cell in the other end of the connection. */
+        const std::vector< size_t >& neighbours() const;
+        const std::vector< int >& faces() const;
+        const std::vector< double >& multipliers() const;
+        const std::vector< Type >& types() const;
+        const std::vector< double >& nncTrans() const;
+
+    private:
+        std::vector< size_t > m_offsets;
+        std::vector< size_t > m_neighbours;
+        std::vector< int > m_faces;
+        std::vector< double > m_multipliers;
+        std::vector< Type > m_types;
+        std::vector< double > m_nnc_trans;
+    };
+}
+
+#endif
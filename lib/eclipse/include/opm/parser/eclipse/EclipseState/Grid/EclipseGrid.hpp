@@ -26,18 +26,23 @@
 #include <opm/parser/eclipse/EclipseState/Grid/MinpvMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/PinchMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
 
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
 
 #include <ert/ecl/ecl_grid.h>
 #include <ert/util/ert_unique_ptr.hpp>
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Opm {
 
+    class CartesianGeometry;
+    class CellLocator;
     class Deck;
     class ZcornMapper;
 
@@ -50,6 +55,13 @@ namespace Opm {
          - Size of cells
          - Real world position of cells
          - Active/inactive status of cells
+
+       Grids created from the cartesian keywords DX/DY/DZ/TOPS or
+       DXV/DYV/DZV/DEPTHZ are an exception: their geometry is
+       computed on demand from the cell sizes, and the ERT grid is
+       only created when c_ptr() is called. exportCOORD(),
+       exportZCORN() and exportACTNUM() build the arrays from the
+       cell sizes without creating the ERT grid.
     */
 
     class EclipseGrid : public GridDims {
@@ -103,6 +115,11 @@ namespace Opm {
           the theta keywords entered sum up to exactly 360 degrees!
         */
         bool circle( ) const;
+        /*
+          True if the grid is given with COORD and ZCORN, false for the
+          block centered grids from DX/DY/DZ/TOPS and DXV/DYV/DZV/DEPTHZ.
+        */
+        bool isCornerPoint( ) const;
         bool isPinchActive( ) const;
         double getPinchThresholdThickness( ) const;
         PinchMode::ModeEnum getPinchOption( ) const;
@@ -135,19 +152,40 @@ namespace Opm {
 
             {
                 std::vector<T> compressed_vector( this->getNumActive() );
-                const auto& active_map = this->getActiveMap( );
-
-                for (size_t i = 0; i < this->getNumActive(); ++i)
-                    compressed_vector[i] = input_vector[ active_map[i] ];
-
+                this->compress( input_vector.data() , compressed_vector.data() );
                 return compressed_vector;
             }
         }
 
+        /*
+          Bulk copy between global and active indexing: compress()
+          copies the values of the active cells from the nx*ny*nz
+          elements of global_data to the num_active elements of
+          active_data, and expand() copies them back - the elements of
+          global_data for inactive cells are left untouched. Large
+          grids are processed in parallel.
+        */
+        template<typename T>
+        void compress(const T* global_data, T* active_data) const {
+            const auto& active_map = this->getActiveMap( );
+            parallel::gather( active_map.size() , active_map.data() , global_data , active_data );
+        }
+
+        template<typename T>
+        void expand(const T* active_data, T* global_data) const {
+            const auto& active_map = this->getActiveMap( );
+            parallel::scatter( active_map.size() , active_map.data() , active_data , global_data );
+        }
+
 
         /// Will return a vector a length num_active; where the value
         /// of each element is the corresponding global index.
         const std::vector<int>& getActiveMap() const;
+
+        /// Will return a vector of length nx*ny*nz; where the value
+        /// of each element is the active index of the cell, or -1 for
+        /// inactive cells.
+        const std::vector<int>& getGlobalToActiveMap() const;
         std::array<double, 3> getCellCenter(size_t i,size_t j, size_t k) const;
         std::array<double, 3> getCellCenter(size_t globalIndex) const;
         std::array<double, 3> getCornerPos(size_t i,size_t j, size_t k, size_t corner_index) const;
@@ -163,6 +201,25 @@ namespace Opm {
         double getCellDepth(size_t globalIndex) const;
         ZcornMapper zcornMapper() const;
 
+        /*
+          The geometry of all cells - centers, depths, volumes,
+          thicknesses and dx/dy - as flat arrays indexed with the
+          global index. The arrays are computed on the first call and
+          then cached; loops over all the cells in the grid should use
+          this instead of the per cell getCellXXX() methods. It is safe
+          to call getGeometry() and findCell() concurrently.
+        */
+        const GridGeometry& getGeometry() const;
+
+        /*
+          Will return the global index of the cell which contains the
+          point (x,y,z), or -1 if the point is outside the grid. The
+          search structure is built on the first call, and findCells()
+          will look up many points in parallel.
+        */
+        int findCell( double x, double y, double z ) const;
+        std::vector< int > findCells( const std::vector< std::array< double, 3 > >& points ) const;
+
         /*
           The exportZCORN method will adjust the z coordinates to ensure that cells do not
           overlap. The return value is the number of points which have been adjusted.
@@ -187,6 +244,9 @@ namespace Opm {
         PinchMode::ModeEnum m_pinchoutMode;
         PinchMode::ModeEnum m_multzMode;
         mutable std::vector< int > activeMap;
+        mutable std::vector< int > m_globalToActive;
+        mutable std::shared_ptr< const GridGeometry > m_geometry;
+        mutable std::shared_ptr< const CellLocator > m_locator;
         bool m_circle = false;
 
         /*
@@ -202,16 +262,43 @@ namespace Opm {
             grid_ptr() = default;
             grid_ptr(grid_ptr&&) = default;
             grid_ptr(const grid_ptr& src) :
-                ert_ptr( ecl_grid_alloc_copy( src.get() ) ) {}
+                ert_ptr( src ? ecl_grid_alloc_copy( src.get() ) : nullptr ) {}
+        };
+        mutable grid_ptr m_grid;
+
+        /*
+          The geometry, the cell locator and, for cartesian grids, the
+          ERT grid are created on demand from const methods, which may
+          be called concurrently; m_cacheMutex serializes that. It is
+          recursive because creating the geometry calls c_ptr(). Like
+          grid_ptr it has copy semantics, a copy gets a fresh mutex.
+        */
+        class cache_mutex : public std::recursive_mutex {
+        public:
+            cache_mutex() = default;
+            cache_mutex(const cache_mutex&) : std::recursive_mutex() {}
+            cache_mutex& operator=(const cache_mutex&) { return *this; }
         };
-        grid_ptr m_grid;
+        mutable cache_mutex m_cacheMutex;
+
+        /*
+          For the cartesian grids m_cartesian holds the geometry and
+          m_actnum the actnum, m_grid is created lazily.
+        */
+        std::shared_ptr< const CartesianGeometry > m_cartesian;
+        std::vector< int > m_actnum;
 
+        void initActiveMaps() const;
+        const CellLocator& getLocator() const;
+        GridGeometry::corner_function cornerFunction() const;
         void initCornerPointGrid(const std::array<int,3>& dims ,
                                  const std::vector<double>& coord ,
                                  const std::vector<double>& zcorn ,
                                  const int * actnum,
                                  const double * mapaxes);
 
+        void initBinaryGrid(            const std::string& filename);
+        void initBinaryGrid(            const std::array<int, 3>&, const Deck&);
         void initCylindricalGrid(       const std::array<int, 3>&, const Deck&);
         void initCartesianGrid(         const std::array<int, 3>&, const Deck&);
         void initCornerPointGrid(       const std::array<int, 3>&, const Deck&);
@@ -0,0 +1,102 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_GRID_GEOMETRY_HPP
+#define OPM_GRID_GEOMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      GridGeometry holds the geometric properties of all the cells in
+      a corner point grid, as one array per property indexed with the
+      global (cartesian) cell index. The arrays are computed in one
+      pass, split over the worker threads, directly from the COORD and
+      ZCORN arrays of the grid - this is much faster than asking the
+      grid for one cell at a time, and code which loops over all the
+      cells should use the arrays:
+
+          const auto& depth = grid.getGeometry().getDepth();
+          for (size_t g = 0; g < grid.getCartesianSize(); g++)
+              values[g] = table.evaluate( "Temperature", depth[g] );
+
+      The values are the same as from the EclipseGrid cell accessors
+      getCellCenter(), getCellDepth(), getCellVolume(),
+      getCellThicknes() and getCellDims().
+
+      Grids without an explicit corner point representation provide
+      the corners of one cell at a time with a corner_function, which
+      is called concurrently for different cells.
+    */
+
+    class GridGeometry {
+    public:
+        /* The corners of one cell, numbered as in EclipseGrid::getCornerPos(). */
+        using corners = std::array< std::array< double, 3 >, 8 >;
+        using corner_function = std::function< void( size_t i, size_t j, size_t k, corners& ) >;
+
+        GridGeometry(size_t nx, size_t ny, size_t nz,
+                     const std::vector<double>& coord,
+                     const std::vector<double>& zcorn);
+
+        GridGeometry(size_t nx, size_t ny, size_t nz,
+                     const corner_function& cell_corners);
+
+        /*
+          The corners of the cells in a corner point grid; the
+          function refers to the coord and zcorn vectors, which must
+          outlive it.
+        */
+        static corner_function cornerPoint( size_t nx, size_t ny, size_t nz,
+                                            const std::vector<double>& coord,
+                                            const std::vector<double>& zcorn );
+
+        /* The geometry of a single cell. */
+        static std::array<double, 3> cellCenter( const corners& p );
+        static double cellVolume( const corners& p );
+        static double cellThickness( const corners& p );
+        static std::array<double, 3> cellDims( const corners& p );
+
+        size_t size() const;
+
+        const std::vector<double>& getCenterX() const;
+        const std::vector<double>& getCenterY() const;
+        /* The z coordinate of the cell center. */
+        const std::vector<double>& getDepth() const;
+        const std::vector<double>& getVolume() const;
+        const std::vector<double>& getThickness() const;
+        const std::vector<double>& getDX() const;
+        const std::vector<double>& getDY() const;
+
+    private:
+        std::vector<double> m_center_x;
+        std::vector<double> m_center_y;
+        std::vector<double> m_depth;
+        std::vector<double> m_volume;
+        std::vector<double> m_thickness;
+        std::vector<double> m_dx;
+        std::vector<double> m_dy;
+    };
+}
+
+#endif
@@ -19,6 +19,7 @@
 #ifndef ECLIPSE_GRIDPROPERTIES_HPP_
 #define ECLIPSE_GRIDPROPERTIES_HPP_
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -133,6 +134,23 @@ namespace Opm {
 
         GridProperty<T>& getOrCreateProperty(const std::string& name);
 
+        /*
+          Will create the property like getOrCreateProperty() - but only
+          if the keyword has a constant default value, i.e. when creating
+          it does not depend on any other properties. Returns true if the
+          property exists afterwards.
+        */
+        bool addConstantKeyword(const std::string& name);
+
+        /*
+          Will store the properties for the active cells of the grid
+          only, see GridProperty::compressToActive(). Properties which
+          are auto created later by the const getKeyword() are
+          compressed as well. The ACTNUM property itself is kept full
+          size.
+        */
+        void compressToActive( const EclipseGrid& grid );
+
         /**
            The fine print of the manual says the ADD keyword should support
            some state dependent semantics regarding endpoint scaling arrays
@@ -149,6 +167,19 @@ namespace Opm {
         void handleMULTIREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
         void handleCOPYREGRecord( const DeckRecord& record, const GridProperty<int>& regionProperty );
         void handleOPERATERecord( const DeckRecord& record , BoxManager& boxManager);
+
+        /*
+          Converts an EQUALS, ADD or MULTIPLY record to an edit of the
+          property, with the same unit conversion as the handleXXXRecord()
+          methods; applyEdits() will then apply a sequence of edits to
+          the property, see GridProperty::apply().
+        */
+        typename GridProperty<T>::Edit makeEdit( const std::string& operation,
+                                                 const DeckRecord& record,
+                                                 const Box& inputBox );
+        void applyEdits( const std::string& keyword,
+                         const std::vector< typename GridProperty<T>::Edit >& edits );
+
         /*
           Iterators over initialized properties. The overloaded
           operator*() opens the pair which comes natively from the
@@ -199,6 +230,9 @@ namespace Opm {
         mutable std::unordered_map<std::string, SupportedKeywordInfo> m_supportedKeywords;
         mutable storage m_properties;
         mutable std::set<std::string> m_autoGeneratedProperties;
+
+        std::shared_ptr< const std::vector< int > > m_globalToActive;
+        size_t m_numActive = 0;
     };
 
 }
@@ -20,9 +20,12 @@
 #define ECLIPSE_GRIDPROPERTY_HPP_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
+
 /*
   This class implemenents a class representing properties which are
   define over an ECLIPSE grid, i.e. with one value for each logical
@@ -31,13 +34,25 @@
 
 namespace Opm {
 
-    class Box;
     class DeckItem;
     class DeckKeyword;
     class EclipseGrid;
+    class RegionIndex;
     class TableManager;
     template< typename > class GridProperties;
 
+/*
+  The initial values of a property given as one value per region of a
+  region property like SATNUM: the cells of region r have the value
+  values[r - 1]. If regions is null the values are instead the values
+  of the individual cells.
+*/
+template< typename T >
+struct GridPropertyLookup {
+    std::shared_ptr< const RegionIndex > regions;
+    std::vector< T > values;
+};
+
 template< typename T >
 class GridPropertySupportedKeywordInfo {
 
@@ -45,6 +60,7 @@ class GridPropertySupportedKeywordInfo {
         GridPropertySupportedKeywordInfo() = default;
 
         using init = std::function< std::vector< T >( size_t ) >;
+        using lookup = std::function< GridPropertyLookup< T >( size_t ) >;
         using post = std::function< void( std::vector< T >& ) >;
 
         GridPropertySupportedKeywordInfo(
@@ -58,6 +74,16 @@ class GridPropertySupportedKeywordInfo {
                 init initializer,
                 const std::string& dimString);
 
+        /*
+          A keyword whose initial values are looked up by region; the
+          property then keeps the region values until it is modified
+          cell by cell. The initializer() expands to all cells.
+        */
+        GridPropertySupportedKeywordInfo(
+                const std::string& name,
+                lookup lookupInitializer,
+                const std::string& dimString);
+
         /* this is a convenience constructor which can be used if the default
          * value for the grid property is just a constant.
          */
@@ -75,14 +101,30 @@ class GridPropertySupportedKeywordInfo {
         const std::string& getKeywordName() const;
         const std::string& getDimensionString() const;
         const init& initializer() const;
+        const lookup& lookupInitializer() const;
         const post& postProcessor() const;
 
+        /*
+          Keywords created with a constant default value, and without a
+          post processor, can be stored as one value until they are
+          assigned values which vary from cell to cell.
+        */
+        bool hasDefaultValue() const;
+        T getDefaultValue() const;
+        bool hasPostProcessor() const;
+        bool hasLookup() const;
+
     private:
 
         std::string m_keywordName;
         init m_initializer;
+        lookup m_lookup;
         post m_postProcessor;
         std::string m_dimensionString;
+        T m_defaultValue = T();
+        bool m_hasDefaultValue = false;
+        bool m_hasPostProcessor = false;
+        bool m_hasLookup = false;
 };
 
 template< typename T >
@@ -90,6 +132,33 @@ class GridProperty {
 public:
     typedef GridPropertySupportedKeywordInfo<T> SupportedKeywordInfo;
 
+    /*
+      The values are stored in one of five forms:
+
+        Constant: all cells have the same value.
+
+        Boxes: a background value and a list of IJK boxes which have
+               been assigned a value; later boxes take precedence.
+
+        Dense: one value for each cell.
+
+        Compressed: one value for each active cell, see
+               compressToActive().
+
+        Lookup: one value for each region of a region property, with
+               a shared RegionIndex to find the region of a cell.
+
+      A property starts out as Constant if the keyword has a constant
+      default value, or as Lookup if it has a lookup initializer, and
+      is only promoted to Dense when it is assigned values which vary
+      from cell to cell, or when the full array is
+      requested with getData(). Observe that getData() const will
+      allocate the array on the first call; it should not be called
+      concurrently from several threads for a property which is not
+      yet Dense.
+    */
+    enum class Storage { Constant, Boxes, Dense, Compressed, Lookup };
+
     GridProperty( size_t nx, size_t ny, size_t nz, const SupportedKeywordInfo& kwInfo );
 
     size_t getCartesianSize() const;
@@ -104,9 +173,43 @@ public:
     void iset(size_t i , size_t j , size_t k , T value);
 
 
+    /*
+      The values of all the cells. For a property which is not Dense
+      this allocates the full array and switches the property to
+      Dense storage for good, also for a Compressed property; it is
+      not safe to call concurrently before the property is Dense. Code
+      which only reads the values should use iget() or forEachRange(),
+      which leave the storage alone and may be called from several
+      threads.
+    */
     const std::vector<T>& getData() const;
     std::vector<T>& getData();
 
+    Storage getStorage() const;
+
+    /*
+      Will call f( begin, end, value ) for consecutive ranges
+      [begin,end) of global indices which have the same value, in
+      increasing order. This does not allocate the full array for
+      Constant, Boxes and Lookup storage.
+    */
+    void forEachRange( const std::function< void( size_t, size_t, T ) >& f ) const;
+
+    /*
+      Will store the values of the active cells only; globalToActive
+      is the global -> active index map of the grid with -1 for the
+      inactive cells. The values of the inactive cells are discarded:
+      they read back as the default value of the keyword, or T() for
+      keywords with an initializer instead of a default, and writes
+      to them are ignored. Constant and Lookup properties are left as
+      they are. The box and region operations work on the compressed
+      values directly, whereas getData() expands the property to
+      Dense storage again; it stays Dense, with the inactive cells at
+      the default value, until it is compressed again.
+    */
+    void compressToActive( std::shared_ptr< const std::vector< int > > globalToActive,
+                           size_t numActive );
+
     bool containsNaN() const;
     const std::string& getDimensionString() const;
 
@@ -118,6 +221,23 @@ public:
     void maskedCopy( const GridProperty< T >& other, const std::vector< bool >& mask );
     void initMask( T value, std::vector<bool>& mask ) const;
 
+    /*
+      The region operations only visit the cells of region in the
+      index; see regionIndex().
+    */
+    void regionSet( T value, const RegionIndex& index, int region );
+    void regionMultiply( T value, const RegionIndex& index, int region );
+    void regionAdd( T value, const RegionIndex& index, int region );
+    void regionCopy( const GridProperty< T >& other, const RegionIndex& index, int region );
+
+    /*
+      Only for GridProperty<int>: the region index of the property,
+      which is built on the first call and kept until the property is
+      modified. The returned pointer stays valid also if the property
+      is modified while it is in use.
+    */
+    std::shared_ptr< const RegionIndex > regionIndex() const;
+
     /**
        Due to the convention where it is only necessary to supply the
        top layer of the petrophysical properties we can unfortunately
@@ -133,6 +253,23 @@ public:
     void add( T shiftValue, const Box& );
     void setScalar( T value, const Box& );
 
+    /*
+      An EQUALS, ADD or MULTIPLY operation on the cells of a box. A
+      sequence of edits is applied with apply(), which gives the same
+      result as calling setScalar(), add() and scale() in order - but
+      for Dense storage consecutive edits are done in one pass over
+      the cells, applying all the edits to a cell before moving on.
+    */
+    struct Edit {
+        enum class Kind { Set, Add, Scale };
+
+        Kind kind;
+        T value;
+        Box box;
+    };
+
+    void apply( const std::vector< Edit >& edits );
+
     const std::string& getKeywordName() const;
     const SupportedKeywordInfo& getKeywordInfo() const;
 
@@ -177,12 +314,38 @@ public:
      std::vector<T> compressedCopy( const EclipseGrid& grid) const;
 
 private:
+    struct BoxValue {
+        size_t i1, i2, j1, j2, k1, k2;
+        T value;
+
+        bool contains( size_t i, size_t j, size_t k ) const;
+        bool intersects( const BoxValue& other ) const;
+    };
+
+    /* Beyond this many boxes the property is stored dense. */
+    static const size_t maxBoxes = 64;
+
     const DeckItem& getDeckItem( const DeckKeyword& );
     void setDataPoint(size_t sourceIdx, size_t targetIdx, const DeckItem& deckItem);
 
+    BoxValue makeBox( const Box& inputBox, T value ) const;
+    bool uniformValue( const Box& inputBox, T& value ) const;
+    void materialize() const;
+    void makeWritable();
+    T* cellPointer( size_t index );
+    template< typename F > void updateCells( const Box& inputBox, F f );
+    void applyFused( const Edit* edits, size_t size );
+    template< typename F > void updateRegion( const RegionIndex& index, int region, F f );
+
     size_t m_nx, m_ny, m_nz;
     SupportedKeywordInfo m_kwInfo;
-    std::vector<T> m_data;
+    mutable Storage m_storage;
+    T m_value;
+    mutable std::vector< BoxValue > m_boxes;
+    mutable std::vector<T> m_data;
+    mutable std::shared_ptr< const std::vector< int > > m_globalToActive;
+    mutable std::shared_ptr< const RegionIndex > m_regionIndex;
+    mutable std::shared_ptr< const RegionIndex > m_lookupIndex;
     bool m_hasRunPostProcessor = false;
 };
 
@@ -29,6 +29,8 @@
 namespace Opm {
 
     template< typename > class GridProperties;
+    template< typename > class GridProperty;
+    class GridDims;
 
     class DeckRecord;
     class DeckKeyword;
@@ -74,11 +76,52 @@ namespace Opm {
                         const std::vector< const DeckKeyword* >& keywords);
         double getRegionMultiplier(size_t globalCellIdx1, size_t globalCellIdx2, FaceDir::DirEnum faceDir) const;
 
+        /*
+          The region multipliers of the connections from every cell in
+          the grid to the neighbour in the direction faceDir, which
+          must be one of XPlus, YPlus and ZPlus; the cells on the
+          boundary get multiplier 1.0.
+        */
+        std::vector< double > getRegionMultipliers(const GridDims& dims, FaceDir::DirEnum faceDir) const;
+
+        /*
+          The region multiplier of an explicit NNC between the two
+          cells; the records with NNC behaviour NNC or ALL apply,
+          irrespective of their directions.
+        */
+        double getNNCMultiplier(size_t globalCellIdx1, size_t globalCellIdx2) const;
+
     private:
+        /*
+          The MULTREGT records of one region keyword, as a dense table
+          over the region values which appear in the records: values
+          is the sorted list of these region values, and the position
+          of a region value in the list is its id. Entry
+          (id1 * values.size() + id2) in records is the index in
+          m_records of the record for region1 -> region2, or -1; the
+          table size is given by the number of distinct region values
+          in the records, and not by the largest value.
+        */
+        struct RegionTable {
+            const GridProperty< int >* regions;
+            std::vector< int > values;
+            std::vector< int > records;
+        };
+
         void addKeyword( const DeckKeyword& deckKeyword, const std::string& defaultRegion);
         void assertKeywordSupported(const DeckKeyword& deckKeyword, const std::string& defaultRegion);
+        const MULTREGTRecord* lookup(const RegionTable& table, int regionId1, int regionId2, int directions) const;
+        /*
+          The record of the table which applies to the connection
+          between the cells, given their region values; this includes
+          the NNC behaviour of the record. Returns nullptr if no record
+          applies.
+        */
+        const MULTREGTRecord* applicable(const RegionTable& table, size_t globalIndex1, size_t globalIndex2,
+                                         int regionId1, int regionId2, FaceDir::DirEnum faceDir) const;
+
         std::vector< MULTREGTRecord > m_records;
-        std::map<std::string , MULTREGTSearchMap> m_searchMap;
+        std::vector< RegionTable > m_tables;
         const Eclipse3DProperties& m_e3DProps;
     };
 
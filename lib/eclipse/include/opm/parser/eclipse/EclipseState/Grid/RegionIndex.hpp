@@ -0,0 +1,96 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_REGION_INDEX_HPP
+#define OPM_REGION_INDEX_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+    template< typename > class GridProperty;
+
+    /*
+      RegionIndex is the inverse of a region property like FLUXNUM or
+      MULTNUM: for every region value the cells of the region, stored
+      in compressed sparse row form as ranges [begin,end) of global
+      indices in increasing order. The distinct region values are
+      kept in a sorted list, and the ranges of the region at position
+      r in that list are the entries [offsets[r], offsets[r + 1]) of
+      the range array; the size of the index is given by the number
+      of distinct regions and ranges, not by the region values.
+
+      The index is built with one pass over the region property, and
+      the region operations EQUALREG, ADDREG, MULTIREG and COPYREG
+      then only visit the cells of the region. Use
+      GridProperty<int>::regionIndex() to get an index which is kept
+      until the region property is modified.
+    */
+
+    class RegionIndex {
+    public:
+        explicit RegionIndex( const GridProperty< int >& regions );
+
+        /* The smallest and largest region value, or 0 and -1 if empty. */
+        int minRegion() const;
+        int maxRegion() const;
+
+        /* The region values with at least one cell, in increasing order. */
+        std::vector< int > regions() const;
+
+        size_t numCells( int region ) const;
+        std::vector< size_t > cells( int region ) const;
+
+        /*
+          Will call f( begin, end ) for the ranges of global indices
+          in the region, in increasing order.
+        */
+        void forEachRange( int region, const std::function< void( size_t, size_t ) >& f ) const;
+
+        /*
+          The region of the cell with global index index; found with a
+          binary search among the ranges in global order.
+        */
+        int region( size_t index ) const;
+
+        /*
+          Will call f( begin, end, region ) for all the ranges, in
+          increasing order of global index.
+        */
+        void forEachRange( const std::function< void( size_t, size_t, int ) >& f ) const;
+
+    private:
+        /* The position of region in m_regions, or m_regions.size(). */
+        size_t position( int region ) const;
+
+        std::vector< int > m_regions;
+        std::vector< size_t > m_offsets;
+        std::vector< std::pair< size_t, size_t > > m_ranges;
+
+        /* The first cell and region of each range, in global order. */
+        std::vector< size_t > m_begins;
+        std::vector< int > m_values;
+        size_t m_size = 0;
+    };
+}
+
+#endif
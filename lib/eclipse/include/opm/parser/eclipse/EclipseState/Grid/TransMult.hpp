@@ -25,14 +25,19 @@
 
       {MULTX , MULTX- , MULTY , MULTY- , MULTZ , MULTZ-, MULTFLT , MULTREGT}
 
+   The multipliers are stored as one array per face direction, and
+   the array is only allocated when a multiplier is applied in that
+   direction; for the other directions all the multipliers are 1.0.
 */
 #ifndef OPM_PARSER_TRANSMULT_HPP
 #define OPM_PARSER_TRANSMULT_HPP
 
 
+#include <array>
 #include <cstddef>
-#include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
@@ -42,6 +47,7 @@ namespace Opm {
     class Fault;
     class FaultCollection;
     class Eclipse3DProperties;
+    class EclipseGrid;
     class DeckKeyword;
 
     class TransMult {
@@ -51,21 +57,43 @@ namespace Opm {
         double getMultiplier(size_t globalIndex, FaceDir::DirEnum faceDir) const;
         double getMultiplier(size_t i , size_t j , size_t k, FaceDir::DirEnum faceDir) const;
         double getRegionMultiplier( size_t globalCellIndex1, size_t globalCellIndex2, FaceDir::DirEnum faceDir) const;
+        std::vector< double > getRegionMultipliers( FaceDir::DirEnum faceDir ) const;
+        double getNNCMultiplier( size_t globalCellIndex1, size_t globalCellIndex2 ) const;
         void applyMULT(const GridProperty<double>& srcMultProp, FaceDir::DirEnum faceDir);
         void applyMULTFLT(const FaultCollection& faults);
         void applyMULTFLT(const Fault& fault);
 
+        /*
+          Multiply the multipliers across the faces of the faults with
+          the paired factors, for all the faults in one pass.
+        */
+        void applyMULTFLT(const std::vector< std::pair< const Fault*, double > >& faultFactors);
+
+        /*
+          True if all the multipliers in direction faceDir are 1.0,
+          in which case getMultipliers( faceDir ) is empty.
+        */
+        bool isUniform(FaceDir::DirEnum faceDir) const;
+
+        /*
+          The multipliers of all the cells in direction faceDir,
+          indexed with the global cell index; the vector is empty if
+          the direction is uniform. getActiveMultipliers() returns
+          the multipliers of the active cells, also for the uniform
+          directions.
+        */
+        const std::vector<double>& getMultipliers(FaceDir::DirEnum faceDir) const;
+        std::vector<double> getActiveMultipliers(const EclipseGrid& grid, FaceDir::DirEnum faceDir) const;
+
     private:
         size_t getGlobalIndex(size_t i , size_t j , size_t k) const;
         void assertIJK(size_t i , size_t j , size_t k) const;
         double getMultiplier__(size_t globalIndex , FaceDir::DirEnum faceDir) const;
-        void insertNewProperty(FaceDir::DirEnum faceDir);
-        bool hasDirectionProperty(FaceDir::DirEnum faceDir) const;
-        GridProperty<double>& getDirectionProperty(FaceDir::DirEnum faceDir);
+        std::vector<double>& getDirectionMultipliers(FaceDir::DirEnum faceDir);
 
         size_t m_nx , m_ny , m_nz;
-        std::map<FaceDir::DirEnum , GridProperty<double> > m_trans;
-        std::map<FaceDir::DirEnum , std::string> m_names;
+        /* One array per direction, in the order XPlus, XMinus, YPlus, YMinus, ZPlus, ZMinus */
+        std::array< std::vector<double> , 6 > m_trans;
         MULTREGTScanner m_multregtScanner;
     };
 
@@ -20,7 +20,11 @@
 #ifndef MESSAGECONTAINER_H
 #define MESSAGECONTAINER_H
 
+#include <functional>
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 
@@ -59,6 +63,14 @@ namespace Opm {
         type mtype;
         std::string message;
         Location location;
+        /*
+          The category is typically the ParseContext key of the error which
+          generated the message; messages added without a category have an
+          empty category. The count is the number of times this message has
+          been reported - identical messages are only stored once.
+        */
+        std::string category;
+        size_t count = 1;
     };
 
 
@@ -67,6 +79,14 @@ namespace Opm {
     public:
 
         using const_iterator = std::vector< Message >::const_iterator;
+        using formatter = std::function< std::string() >;
+
+        /*
+          The maximum number of distinct messages stored per (non-empty)
+          category. Messages reported beyond the limit are only counted, and
+          for the lazy add() overloads the message text is never formatted.
+        */
+        static const size_t defaultCategoryLimit = 1000;
 
         void error(const std::string& msg, const std::string& filename, const size_t lineno);
         void error(const std::string& msg);
@@ -91,16 +111,57 @@ namespace Opm {
 
         void add( const Message& );
         void add( Message&& );
-        
+
+        /*
+          Add a message in a category. With the formatter overloads the
+          message text is created by calling msg(), which only happens if
+          the category has not yet reached the category limit, or if a
+          message of the same type and location has been stored - the new
+          message may repeat it, and then only bumps its count.
+        */
+        void add( const std::string& category, Message::type mtype, const std::string& msg );
+        void add( const std::string& category, Message::type mtype, const formatter& msg );
+        void add( const std::string& category, Message::type mtype, const formatter& msg,
+                  const std::string& filename, const size_t lineno );
+
         void appendMessages(const MessageContainer& other);
-        
+        void appendMessages(MessageContainer&& other);
+
+        void setCategoryLimit( size_t limit );
+        size_t getCategoryLimit() const;
+
+        /*
+          count() is the total number of messages reported in a category,
+          including repeated messages and the messages dropped because of
+          the category limit; dropped() is the number of dropped messages.
+        */
+        size_t count( const std::string& category ) const;
+        size_t dropped( const std::string& category ) const;
+
         const_iterator begin() const;
         const_iterator end() const;
 
         std::size_t size() const;
-        
+
     private:
+        struct Counter {
+            size_t reported = 0;
+            size_t stored = 0;
+            size_t dropped = 0;
+        };
+
+        void insert( Message&& msg );
+        bool full( const std::string& category ) const;
+        bool stored( const std::string& category, Message::type mtype,
+                     const std::string& filename, const size_t lineno ) const;
+
         std::vector<Message> m_messages;
+        /* hash of the message -> position in m_messages, used for dedup */
+        std::unordered_multimap< size_t, size_t > m_index;
+        /* hash of the category, type and location of the stored messages */
+        std::unordered_set< size_t > m_sites;
+        std::map< std::string, Counter > m_categories;
+        size_t m_limit = defaultCategoryLimit;
     };
 
 } // namespace Opm
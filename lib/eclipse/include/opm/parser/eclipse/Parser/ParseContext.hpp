@@ -78,11 +78,50 @@ namespace Opm {
 
     class ParseContext {
     public:
+        /*
+          Integer ids for the predefined error keys - the keys which are
+          registered by the constructor. The actions of these keys are
+          stored in a dense array, so handleError() and get() with an id
+          is an array lookup instead of a string keyed map lookup; this is
+          the version to use in the parser inner loops. The ids are named
+          as the corresponding string constants, i.e.
+
+             parseContext.get( ParseContext::ErrorKey::PARSE_RANDOM_TEXT )
+             parseContext.get( ParseContext::PARSE_RANDOM_TEXT )
+
+          are equivalent. The string API is still the only way to
+          configure a ParseContext.
+        */
+        enum class ErrorKey : int {
+            PARSE_UNKNOWN_KEYWORD = 0,
+            PARSE_RANDOM_TEXT,
+            PARSE_RANDOM_SLASH,
+            PARSE_MISSING_DIMS_KEYWORD,
+            PARSE_EXTRA_DATA,
+            PARSE_MISSING_INCLUDE,
+            UNSUPPORTED_SCHEDULE_GEO_MODIFIER,
+            UNSUPPORTED_COMPORD_TYPE,
+            UNSUPPORTED_INITIAL_THPRES,
+            UNSUPPORTED_TERMINATE_IF_BHP,
+            INTERNAL_ERROR_UNINITIALIZED_THPRES,
+            SUMMARY_UNKNOWN_WELL,
+            SUMMARY_UNKNOWN_GROUP,
+            NUM_KEYS
+        };
+
         ParseContext();
         explicit ParseContext(InputError::Action default_action);
         explicit ParseContext(const std::vector<std::pair<std::string , InputError::Action>>& initial);
 
         Message::type handleError( const std::string& errorKey, MessageContainer& msgContainer, const std::string& msg ) const;
+        /*
+          Lazy version of handleError(); msg() is only called when the
+          error is actually recorded in the message container or thrown,
+          i.e. ignored errors do not pay for formatting the message.
+        */
+        Message::type handleError( const std::string& errorKey, MessageContainer& msgContainer, const MessageContainer::formatter& msg ) const;
+        Message::type handleError( ErrorKey errorKey, MessageContainer& msgContainer, const std::string& msg ) const;
+        Message::type handleError( ErrorKey errorKey, MessageContainer& msgContainer, const MessageContainer::formatter& msg ) const;
         bool hasKey(const std::string& key) const;
         ParseContext  withKey(const std::string& key, InputError::Action action = InputError::WARN) const;
         ParseContext& withKey(const std::string& key, InputError::Action action = InputError::WARN);
@@ -90,6 +129,8 @@ namespace Opm {
         void update(InputError::Action action);
         void update(const std::string& keyString , InputError::Action action);
         InputError::Action get(const std::string& key) const;
+        InputError::Action get(ErrorKey key) const;
+        static const std::string& keyName(ErrorKey key);
         std::map<std::string,InputError::Action>::const_iterator begin() const;
         std::map<std::string,InputError::Action>::const_iterator end() const;
         /*
@@ -229,7 +270,13 @@ namespace Opm {
         void initEnv();
         void envUpdate( const std::string& envVariable , InputError::Action action );
         void patternUpdate( const std::string& pattern , InputError::Action action);
+        void setAction( const std::string& key , InputError::Action action );
+        Message::type handleError( InputError::Action action, const std::string& errorKey,
+                                   MessageContainer& msgContainer,
+                                   const MessageContainer::formatter& msg ) const;
+
         std::map<std::string , InputError::Action> m_errorContexts;
+        std::vector< InputError::Action > m_actions;
 }; }
 
 
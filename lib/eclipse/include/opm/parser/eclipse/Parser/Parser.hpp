@@ -78,6 +78,14 @@ namespace Opm {
         void loadKeywordsFromDirectory(const boost::filesystem::path& directory , bool recursive = true);
         void applyUnitsToDeck(Deck& deck) const;
 
+        /*
+          Collect ParserStatistics in the subsequent parse operations. The
+          statistics are returned with the Deck, in
+          Deck::getParserStatistics(); the Parser itself is not modified
+          by a parse, and can be shared between threads.
+        */
+        void enableStatistics( bool enable = true );
+
         /*!
          * \brief Returns the approximate number of recognized keywords in decks
          *
@@ -113,6 +121,7 @@ namespace Opm {
                 const ParseContext& context = ParseContext());
 
     private:
+        bool m_collectStatistics = false;
         // associative map of the parser internal name and the corresponding ParserKeyword object
         std::vector< std::unique_ptr< const ParserKeyword > > keyword_storage;
         // associative map of deck names and the corresponding ParserKeyword object
@@ -0,0 +1,111 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSER_STATISTICS_HPP
+#define OPM_PARSER_STATISTICS_HPP
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      ParserStatistics records where the time goes when parsing a deck:
+      wall time and bytes for the different phases of the parser, per
+      keyword name aggregates and the include tree with per file timings.
+
+      Collecting statistics is opt-in; when enabled with
+      Parser::enableStatistics() the statistics of a parse are available
+      from the resulting Deck:
+
+          Parser parser;
+          parser.enableStatistics();
+          auto deck = parser.parseFile( "CASE.DATA", parseContext );
+          deck.getParserStatistics()->writeTable( std::cout );
+    */
+    class ParserStatistics {
+    public:
+        enum class phase : int {
+            file_io = 0,     // reading the input files
+            clean,           // stripping comments, whitespace and slashes
+            raw_split,       // splitting the input in raw keywords and records
+            keyword_parse,   // ParserKeyword::parse
+            units,           // Parser::applyUnitsToDeck
+            num_phases
+        };
+
+        struct timing {
+            size_t count = 0;
+            size_t bytes = 0;
+            double seconds = 0;
+        };
+
+        struct keyword_statistics {
+            size_t count = 0;
+            size_t bytes = 0;
+            size_t values = 0;
+            double seconds = 0;
+        };
+
+        /*
+          The files are stored in the order they are opened; parent is the
+          index of the including file, or ParserStatistics::root for the
+          top level file. The read time covers file io and cleaning, the
+          parse time is the time spent parsing keywords from this file.
+        */
+        struct file_statistics {
+            std::string path;
+            size_t parent;
+            size_t depth;
+            size_t bytes = 0;
+            double read_seconds = 0;
+            double parse_seconds = 0;
+        };
+
+        static const size_t root;
+
+        void add( phase p, double seconds, size_t bytes = 0 );
+        void addKeyword( const std::string& name, size_t bytes, size_t values, double seconds );
+        size_t addFile( const std::string& path, size_t parent );
+        file_statistics& getFile( size_t index );
+        void setTotal( double seconds );
+
+        const timing& get( phase p ) const;
+        const std::map< std::string, keyword_statistics >& keywords() const;
+        const std::vector< file_statistics >& files() const;
+        double total() const;
+
+        static const std::string& phaseName( phase p );
+
+        void writeTable( std::ostream& stream ) const;
+        void writeJSON( std::ostream& stream ) const;
+
+    private:
+        std::array< timing, static_cast< size_t >( phase::num_phases ) > m_phases;
+        std::map< std::string, keyword_statistics > m_keywords;
+        std::vector< file_statistics > m_files;
+        double m_total = 0;
+    };
+}
+
+#endif
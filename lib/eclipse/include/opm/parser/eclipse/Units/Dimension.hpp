@@ -20,6 +20,7 @@
 #ifndef DIMENSION_H
 #define DIMENSION_H
 
+#include <cstddef>
 #include <string>
 
 namespace Opm {
@@ -35,6 +36,16 @@ namespace Opm {
         double convertRawToSi(double rawValue) const;
         double convertSiToRaw(double siValue) const;
 
+        /*
+          Bulk conversion of size values from raw to si; with a
+          stride > 1 only every stride'th element, starting at the
+          first, is converted. Elements in between are left
+          untouched, so that multi-dimensional items can be converted
+          with one strided pass per dimension.
+        */
+        void convertRawToSi(const double* raw, double* si, size_t size, size_t stride = 1) const;
+        void convertSiToRaw(const double* si, double* raw, size_t size, size_t stride = 1) const;
+
         bool equal(const Dimension& other) const;
         const std::string& getName() const;
         bool isCompositable() const;
@@ -92,6 +92,8 @@ namespace Opm {
         double to_si( measure, double ) const;
         void from_si( measure, std::vector<double>& ) const;
         void to_si( measure, std::vector<double>& ) const;
+        void from_si( measure, const double* in, double* out, size_t size ) const;
+        void to_si( measure, const double* in, double* out, size_t size ) const;
         const char* name( measure ) const;
 
         static UnitSystem newMETRIC();
@@ -0,0 +1,201 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARALLEL_HPP
+#define OPM_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Opm {
+
+namespace parallel {
+
+    /*
+     * The number of worker threads used by the parallel loops; this is the
+     * hardware concurrency of the machine, unless the environment variable
+     * OPM_NUM_THREADS is set to a positive number. The return value is
+     * always at least one.
+     */
+    size_t num_threads();
+
+    /*
+     * Whether the calling thread runs a chunk of a for_ranges loop or a
+     * task of a task_graph on more than one thread. Loops started from
+     * such a thread run serially on it, so nesting a loop in a parallel
+     * loop or task does not multiply the number of threads; worker_scope
+     * marks the calling thread as a worker for its lifetime.
+     */
+    bool in_worker();
+
+    class worker_scope {
+        public:
+            worker_scope();
+            ~worker_scope();
+
+            worker_scope( const worker_scope& ) = delete;
+            worker_scope& operator=( const worker_scope& ) = delete;
+
+        private:
+            bool previous;
+    };
+
+    /*
+     * for_ranges( size, f, min_chunk ) splits the index range [0,size) in
+     * contiguous chunks and calls f( begin, end ) once for every chunk. The
+     * chunks are processed concurrently, one chunk per thread, with the
+     * calling thread processing the first chunk. Ranges which are too small
+     * to give every thread at least min_chunk elements are split in fewer
+     * chunks, i.e. for small ranges f( 0, size ) is called directly on the
+     * calling thread; so are all ranges when called from a worker.
+     *
+     * f must be safe to call concurrently for disjoint ranges. If f throws,
+     * all threads are joined and the first exception is rethrown.
+     *
+     * --
+     *
+     * std::vector< double > x( n );
+     * parallel::for_ranges( x.size(), [&]( size_t begin, size_t end ) {
+     *     for( size_t i = begin; i < end; ++i )
+     *         x[ i ] = std::sqrt( i );
+     * });
+     */
+    template< typename F >
+    void for_ranges( size_t size, F f, size_t min_chunk = 1024 ) {
+        if( min_chunk == 0 ) min_chunk = 1;
+
+        size_t chunks = std::min( num_threads(), size / min_chunk );
+        if( chunks <= 1 || in_worker() ) {
+            if( size > 0 ) f( size_t( 0 ), size );
+            return;
+        }
+
+        const size_t chunk_size = ( size + chunks - 1 ) / chunks;
+        std::vector< std::exception_ptr > errors( chunks );
+        std::vector< std::thread > threads;
+        threads.reserve( chunks - 1 );
+
+        const auto run = [&]( size_t chunk ) {
+            const size_t begin = chunk * chunk_size;
+            const size_t end = std::min( size, begin + chunk_size );
+            worker_scope scope;
+            try {
+                if( begin < end ) f( begin, end );
+            } catch( ... ) {
+                errors[ chunk ] = std::current_exception();
+            }
+        };
+
+        for( size_t chunk = 1; chunk < chunks; ++chunk )
+            threads.emplace_back( run, chunk );
+
+        run( 0 );
+
+        for( auto& thread : threads )
+            thread.join();
+
+        for( const auto& error : errors )
+            if( error ) std::rethrow_exception( error );
+    }
+
+    /*
+     * for_each( size, f, min_chunk ) is the element-wise version of
+     * for_ranges, and calls f( i ) for every i in [0,size).
+     */
+    template< typename F >
+    void for_each( size_t size, F f, size_t min_chunk = 1024 ) {
+        for_ranges( size, [&f]( size_t begin, size_t end ) {
+            for( size_t index = begin; index < end; ++index )
+                f( index );
+        }, min_chunk );
+    }
+
+    /*
+     * gather( size, index, src, dst ) sets dst[ i ] = src[ index[ i ] ] and
+     * scatter( size, index, src, dst ) sets dst[ index[ i ] ] = src[ i ] for
+     * every i in [0,size); for scatter the indices must be unique. The inner
+     * loops are plain enough for the compiler to vectorize them with gather
+     * and scatter instructions when the target supports it.
+     */
+    template< typename I, typename T >
+    void gather( size_t size, const I* index, const T* src, T* dst,
+                 size_t min_chunk = 1 << 16 ) {
+        for_ranges( size, [=]( size_t begin, size_t end ) {
+            for( size_t i = begin; i < end; ++i )
+                dst[ i ] = src[ index[ i ] ];
+        }, min_chunk );
+    }
+
+    template< typename I, typename T >
+    void scatter( size_t size, const I* index, const T* src, T* dst,
+                  size_t min_chunk = 1 << 16 ) {
+        for_ranges( size, [=]( size_t begin, size_t end ) {
+            for( size_t i = begin; i < end; ++i )
+                dst[ index[ i ] ] = src[ i ];
+        }, min_chunk );
+    }
+
+    /*
+     * task_graph runs a list of tasks which work on named resources, e.g.
+     * grid properties. A task depends on the earlier tasks which share a
+     * resource with it; tasks on the same resource therefore run in the
+     * order they were added, whereas independent chains run concurrently
+     * on num_threads() threads. Every task has exclusive access to its
+     * resources while it runs. When the tasks run on several threads the
+     * parallel loops inside a task run serially.
+     *
+     * run() waits for all the tasks, and clears the graph. If tasks throw,
+     * the exception of the first of them in insertion order is rethrown,
+     * i.e. the same exception as when running the tasks one by one. Tasks
+     * added after a failed task are not started once the failure is seen.
+     *
+     * --
+     *
+     * parallel::task_graph tasks;
+     * tasks.add( [&] { poro.scale( 2 ); }, { "PORO" } );
+     * tasks.add( [&] { permx.add( 1 ); }, { "PERMX" } );
+     * tasks.add( [&] { ntg.copy( poro ); }, { "NTG", "PORO" } );
+     * tasks.run();
+     */
+    class task_graph {
+        public:
+            void add( std::function< void() > task,
+                      const std::vector< std::string >& resources );
+            void run();
+
+            size_t size() const;
+            bool empty() const;
+
+        private:
+            std::vector< std::function< void() > > tasks;
+            std::vector< std::vector< size_t > > dependents;
+            std::vector< size_t > num_dependencies;
+            std::map< std::string, size_t > last_task;
+    };
+
+}
+}
+
+#endif //OPM_PARALLEL_HPP
@@ -103,6 +103,7 @@ set( keywords
      000_Eclipse100/G/GAS
      000_Eclipse100/G/GCONINJE
      000_Eclipse100/G/GCONPROD
+     000_Eclipse100/G/GDFILE
      000_Eclipse100/G/GDORIENT
      000_Eclipse100/G/GECON
      000_Eclipse100/G/GEFAC
@@ -101,6 +101,34 @@ BOOST_AUTO_TEST_CASE(CreateSubBox) {
 }
 
 
+BOOST_AUTO_TEST_CASE(BoxRanges) {
+    Opm::Box globalBox( 5,4,3 );
+    Opm::Box rows( globalBox , 1,3,1,2,0,2 );
+    Opm::Box planes( globalBox , 0,4,1,2,1,2 );
+    Opm::Box layers( globalBox , 0,4,0,3,1,2 );
+
+    for (const auto* box : { &globalBox, &rows, &planes, &layers }) {
+        std::vector< size_t > indices;
+        size_t numRanges = 0;
+        box->forEachRange( [&]( size_t begin, size_t end ) {
+                BOOST_CHECK( begin < end );
+                for (size_t g = begin; g < end; g++)
+                    indices.push_back( g );
+                numRanges++;
+            } );
+
+        BOOST_CHECK( indices == box->getIndexList() );
+        BOOST_CHECK( std::vector< size_t >( box->begin(), box->end() ) == indices );
+        if (box == &rows)
+            BOOST_CHECK_EQUAL( numRanges, 6U );
+        else if (box == &planes)
+            BOOST_CHECK_EQUAL( numRanges, 2U );
+        else
+            BOOST_CHECK_EQUAL( numRanges, 1U );
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(BoxEqual) {
     Opm::Box globalBox1( 10,10,10 );
     Opm::Box globalBox2( 10,10,10 );
@@ -0,0 +1,230 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE ConnectionGraphTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/ConnectionGraph.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    /*
+      3 x 2 x 3 grid, with the cells (1,1,2) and (3,2,2) inactive; the
+      first is thin enough to be pinched out, the second is not.
+    */
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 2 3 /\n"
+        "GRID\n"
+        "DX\n"
+        " 18*1 /\n"
+        "DY\n"
+        " 18*1 /\n"
+        "DZ\n"
+        " 6*1\n"
+        " 5*1 2\n"
+        " 6*1 /\n"
+        "TOPS\n"
+        " 6*0 /\n"
+        "ACTNUM\n"
+        " 6*1\n"
+        " 0 4*1 0\n"
+        " 6*1 /\n"
+        "PINCH\n"
+        " 1.5 /\n"
+        "MULTX\n"
+        " 18*2 /\n"
+        "MULTNUM\n"
+        " 6*1 12*2 /\n"
+        "MULTREGT\n"
+        " 1 2 0.5 Z 1* M /\n"
+        "/\n"
+        "FAULTS\n"
+        " 'F1' 1 1 1 2 1 3 'X' /\n"
+        "/\n"
+        "MULTFLT\n"
+        " 'F1' 0.1 /\n"
+        "/\n"
+        "NNC\n"
+        " 1 1 1 3 2 3 0.75 /\n"
+        "/\n"
+        "EDIT\n"
+        "\n";
+
+    int opposite( int face ) {
+        if( face & ( FaceDir::XPlus | FaceDir::YPlus | FaceDir::ZPlus ) )
+            return face << 1;
+
+        return face >> 1;
+    }
+
+    /* The index of the connection from global cell g1 to global cell g2 */
+    size_t find( const ConnectionGraph& graph, const EclipseGrid& grid, size_t g1, size_t g2 ) {
+        const size_t a1 = grid.activeIndex( g1 );
+        const size_t a2 = grid.activeIndex( g2 );
+        for( size_t c = graph.offsets()[ a1 ]; c < graph.offsets()[ a1 + 1 ]; c++ )
+            if( graph.neighbours()[ c ] == a2 ) return c;
+
+        throw std::invalid_argument( "No such connection" );
+    }
+
+    bool connected( const ConnectionGraph& graph, const EclipseGrid& grid, size_t g1, size_t g2 ) {
+        try {
+            find( graph, grid, g1, g2 );
+            return true;
+        } catch( const std::invalid_argument& ) {
+            return false;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionGraphSymmetric) {
+    Parser parser;
+    EclipseState state( parser.parseString( deckData, ParseContext() ), ParseContext() );
+    const auto& grid = state.getInputGrid();
+    ConnectionGraph graph( grid, state.getTransMult(), state.getInputNNC() );
+
+    BOOST_CHECK_EQUAL( graph.numCells(), grid.getNumActive() );
+    BOOST_CHECK_EQUAL( graph.offsets().size(), grid.getNumActive() + 1 );
+    BOOST_CHECK_EQUAL( graph.offsets().back(), graph.numConnections() );
+
+    for( size_t a = 0; a < graph.numCells(); a++ ) {
+        for( size_t c = graph.offsets()[ a ]; c < graph.offsets()[ a + 1 ]; c++ ) {
+            const size_t b = graph.neighbours()[ c ];
+            const size_t back = find( graph, grid, grid.getGlobalIndex( b ), grid.getGlobalIndex( a ) );
+
+            BOOST_CHECK_EQUAL( graph.multipliers()[ c ], graph.multipliers()[ back ] );
+            BOOST_CHECK( graph.types()[ c ] == graph.types()[ back ] );
+            BOOST_CHECK_EQUAL( graph.nncTrans()[ c ], graph.nncTrans()[ back ] );
+
+            if( graph.types()[ c ] == ConnectionGraph::Type::NNC )
+                BOOST_CHECK_EQUAL( graph.faces()[ c ], 0 );
+            else
+                BOOST_CHECK_EQUAL( graph.faces()[ back ], opposite( graph.faces()[ c ] ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionGraphMultipliers) {
+    Parser parser;
+    EclipseState state( parser.parseString( deckData, ParseContext() ), ParseContext() );
+    const auto& grid = state.getInputGrid();
+    ConnectionGraph graph( grid, state.getTransMult(), state.getInputNNC() );
+
+    /* 16 active cells, 25 cartesian, 1 pinch and 1 NNC connection */
+    BOOST_CHECK_EQUAL( graph.numCells(), 16U );
+    BOOST_CHECK_EQUAL( graph.numConnections(), 2 * ( 25U + 1U + 1U ) );
+
+    /* MULTX */
+    const auto c12 = find( graph, grid, 1, 2 );
+    BOOST_CHECK_EQUAL( graph.faces()[ c12 ], FaceDir::XPlus );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ c12 ], 2.0, 1e-12 );
+    BOOST_CHECK( graph.types()[ c12 ] == ConnectionGraph::Type::Cartesian );
+
+    /* MULTX and MULTFLT */
+    const auto c10 = find( graph, grid, 1, 0 );
+    BOOST_CHECK_EQUAL( graph.faces()[ c10 ], FaceDir::XMinus );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ c10 ], 0.2, 1e-12 );
+
+    /* MULTREGT between the top layer and the rest */
+    const auto c17 = find( graph, grid, 1, 7 );
+    BOOST_CHECK_EQUAL( graph.faces()[ c17 ], FaceDir::ZPlus );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ c17 ], 0.5, 1e-12 );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ find( graph, grid, 7, 13 ) ], 1.0, 1e-12 );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ find( graph, grid, 7, 8 ) ], 2.0, 1e-12 );
+
+    /* Pinched out cell */
+    const auto c0_12 = find( graph, grid, 0, 12 );
+    BOOST_CHECK_EQUAL( graph.faces()[ c0_12 ], FaceDir::ZPlus );
+    BOOST_CHECK( graph.types()[ c0_12 ] == ConnectionGraph::Type::Pinch );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ c0_12 ], 0.5, 1e-12 );
+    BOOST_CHECK( !connected( graph, grid, 5, 17 ) );
+
+    /* NNC */
+    const auto nnc = find( graph, grid, 0, 17 );
+    BOOST_CHECK( graph.types()[ nnc ] == ConnectionGraph::Type::NNC );
+    /* The MULTREGT record has NNC behaviour ALL, and applies to the NNC */
+    BOOST_CHECK_CLOSE( graph.multipliers()[ nnc ], 0.5, 1e-12 );
+    /* The input transmissibility in SI units */
+    BOOST_CHECK_EQUAL( state.getInputNNC().nncdata().size(), 1U );
+    BOOST_CHECK_EQUAL( graph.nncTrans()[ nnc ], state.getInputNNC().nncdata()[0].trans );
+    BOOST_CHECK( graph.nncTrans()[ nnc ] > 0 );
+    BOOST_CHECK_EQUAL( graph.nncTrans()[ c12 ], 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionGraphFaultJuxtaposition) {
+    /*
+      2 x 1 x 2 corner point grid with unit cells, where the right
+      column is shifted half a cell down along the middle pillars.
+    */
+    const char* faultDeck =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 2 1 2 /\n"
+        "GRID\n"
+        "COORD\n"
+        " 0 0 0  0 0 3\n"
+        " 1 0 0  1 0 3\n"
+        " 2 0 0  2 0 3\n"
+        " 0 1 0  0 1 3\n"
+        " 1 1 0  1 1 3\n"
+        " 2 1 0  2 1 3 /\n"
+        "ZCORN\n"
+        " 0 0 0.5 0.5  0 0 0.5 0.5\n"
+        " 1 1 1.5 1.5  1 1 1.5 1.5\n"
+        " 1 1 1.5 1.5  1 1 1.5 1.5\n"
+        " 2 2 2.5 2.5  2 2 2.5 2.5 /\n"
+        "MULTX\n"
+        " 4*3 /\n"
+        "EDIT\n"
+        "\n";
+
+    Parser parser;
+    EclipseState state( parser.parseString( faultDeck, ParseContext() ), ParseContext() );
+    const auto& grid = state.getInputGrid();
+    ConnectionGraph graph( grid, state.getTransMult(), state.getInputNNC() );
+
+    /* 2 vertical, 2 cartesian and 1 fault connection across the fault */
+    BOOST_CHECK_EQUAL( graph.numConnections(), 2 * 5U );
+    BOOST_CHECK( connected( graph, grid, 0, 1 ) );
+    BOOST_CHECK( connected( graph, grid, 2, 3 ) );
+    BOOST_CHECK( !connected( graph, grid, 0, 3 ) );
+
+    const auto c21 = find( graph, grid, 2, 1 );
+    const auto c12 = find( graph, grid, 1, 2 );
+    BOOST_CHECK( graph.types()[ c21 ] == ConnectionGraph::Type::Fault );
+    BOOST_CHECK( graph.types()[ c12 ] == ConnectionGraph::Type::Fault );
+    BOOST_CHECK_EQUAL( graph.faces()[ c21 ], FaceDir::XPlus );
+    BOOST_CHECK_EQUAL( graph.faces()[ c12 ], FaceDir::XMinus );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ c21 ], 3.0, 1e-12 );
+    BOOST_CHECK_CLOSE( graph.multipliers()[ c12 ], 3.0, 1e-12 );
+
+    BOOST_CHECK( graph.types()[ find( graph, grid, 0, 1 ) ] == ConnectionGraph::Type::Cartesian );
+}
@@ -17,6 +17,7 @@
  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
 #include <stdexcept>
 #include <iostream>
 #include <boost/filesystem.hpp>
@@ -31,6 +32,7 @@
 
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
@@ -437,6 +439,65 @@ BOOST_AUTO_TEST_CASE(getRegions) {
     const auto& opernum = s.props.getRegions( "OPERNUM" );
     BOOST_CHECK_EQUAL( 1, opernum.at(0) );
     BOOST_CHECK_EQUAL( 3, opernum.at(1) );
+
+    const auto fipnum = s.props.getRegionIndex( "FIPNUM" );
+    BOOST_CHECK_EQUAL( 2U, fipnum->numCells( 1 ) );
+    BOOST_CHECK_EQUAL( 0U, fipnum->numCells( 4 ) );
+    const std::vector< size_t > cells = { 3 };
+    const auto& region3 = fipnum->cells( 3 );
+    BOOST_CHECK_EQUAL_COLLECTIONS( cells.begin(), cells.end(),
+                                   region3.begin(), region3.end() );
+}
+
+/*
+  Region ids are arbitrary integers; sparse and very large ids must
+  not make the region lookups scale with the value of the ids.
+*/
+BOOST_AUTO_TEST_CASE(getRegionsSparseLargeIds) {
+    const char* input =
+            "RUNSPEC\n"
+            "\n"
+            "DIMENS\n"
+            " 3 1 1 /\n"
+            "GRID\n"
+            "DX\n"
+            "3*0.25 /\n"
+            "DY\n"
+            "3*0.25 /\n"
+            "DZ\n"
+            "3*0.25 /\n"
+            "TOPS\n"
+            "3*0.25 /\n"
+            "PERMX\n"
+            "3*100 /\n"
+            "MULTNUM\n"
+            "1 2000000000 1000000 /\n"
+            "MULTIREG\n"
+            "  PERMX  2  2000000000  M /\n"
+            "/\n"
+            "EQUALREG\n"
+            "  PERMX  7  1000000  M /\n"
+            "/\n"
+            "REGIONS\n"
+            "FIPNUM\n"
+            "1 2000000000 1000000 /\n";
+
+    Setup s( Opm::Parser().parseString(input, Opm::ParseContext() ) );
+
+    std::vector< int > ref = { 1, 1000000, 2000000000 };
+    const auto& regions = s.props.getRegions( "FIPNUM" );
+    BOOST_CHECK_EQUAL_COLLECTIONS( ref.begin(), ref.end(),
+                                   regions.begin(), regions.end() );
+
+    const auto fipnum = s.props.getRegionIndex( "FIPNUM" );
+    BOOST_CHECK_EQUAL( 1U, fipnum->numCells( 2000000000 ) );
+    BOOST_CHECK_EQUAL( 0U, fipnum->numCells( 1999999999 ) );
+    BOOST_CHECK_EQUAL( 1U, fipnum->cells( 2000000000 ).at( 0 ) );
+
+    const auto& permx = s.props.getDoubleGridProperty( "PERMX" );
+    BOOST_CHECK_CLOSE( 100 * Opm::Metric::Permeability, permx.iget( 0 ), 0.0001 );
+    BOOST_CHECK_CLOSE( 200 * Opm::Metric::Permeability, permx.iget( 1 ), 0.0001 );
+    BOOST_CHECK_CLOSE(   7 * Opm::Metric::Permeability, permx.iget( 2 ), 0.0001 );
 }
 
 BOOST_AUTO_TEST_CASE(RadialPermeabilityTensor) {
@@ -476,3 +537,119 @@ BOOST_AUTO_TEST_CASE(TEMPI_TEST) {
     Setup s(createDeck());
     BOOST_CHECK_NO_THROW( s.props.getDoubleGridProperty("TEMPI") );
 }
+
+static Opm::Deck createOperationsDeck() {
+    const char *deckData = "RUNSPEC\n"
+            "\n"
+            "DIMENS\n"
+            " 5 5 1 /\n"
+            "GRID\n"
+            "DX\n"
+            "25*0.25 /\n"
+            "DY\n"
+            "25*0.25 /\n"
+            "DZ\n"
+            "25*0.25 /\n"
+            "TOPS\n"
+            "25*0.25 /\n"
+            "PORO\n"
+            "25*0.20 /\n"
+            "EQUALS\n"
+            "  MULTNUM  1 /\n"
+            "  PERMX  100 /\n"
+            "  PERMY  100 /\n"
+            "  PERMZ   10 /\n"
+            "  MULTNUM  2   1 5 1 2 1 1 /\n"
+            "/\n"
+            "MULTIPLY\n"
+            "  PERMX  2   1 5 1 1 1 1 /\n"
+            "/\n"
+            "MULTIREG\n"
+            "  PERMY  3  2  M /\n"
+            "/\n"
+            "ADD\n"
+            "  MULTNUM  1 /\n"
+            "/\n"
+            "MULTIREG\n"
+            "  PERMZ  5  3  M /\n"
+            "/\n"
+            "COPY\n"
+            "  PERMX  PERMZ   1 5 5 5 1 1 /\n"
+            "/\n"
+            "OPERATE\n"
+            "  NTG  1 5 1 5 1 1  MULTX  PORO  2.0 /\n"
+            "/\n"
+            "\n";
+
+    Opm::Parser parser;
+    return parser.parseString(deckData, Opm::ParseContext() );
+}
+
+/*
+  The operations on different properties may be applied concurrently;
+  the result must be the same as applying them in deck order.
+*/
+BOOST_AUTO_TEST_CASE(OperationsInDeckOrder) {
+    Setup s(createOperationsDeck());
+    const auto& multnum = s.props.getIntGridProperty("MULTNUM");
+    const auto& permx = s.props.getDoubleGridProperty("PERMX");
+    const auto& permy = s.props.getDoubleGridProperty("PERMY");
+    const auto& permz = s.props.getDoubleGridProperty("PERMZ");
+    const auto& ntg = s.props.getDoubleGridProperty("NTG");
+
+    for (size_t j = 0; j < 5; j++) {
+        for (size_t i = 0; i < 5; i++) {
+            BOOST_CHECK_EQUAL(j < 2 ? 3 : 2, multnum.iget(i, j, 0));
+            BOOST_CHECK_CLOSE((j == 0 ? 200 : 100) * Opm::Metric::Permeability, permx.iget(i, j, 0), 0.0001);
+            BOOST_CHECK_CLOSE((j < 2 ? 300 : 100) * Opm::Metric::Permeability, permy.iget(i, j, 0), 0.0001);
+            BOOST_CHECK_CLOSE((j < 2 ? 50 : j == 4 ? 100 : 10) * Opm::Metric::Permeability, permz.iget(i, j, 0), 0.0001);
+            BOOST_CHECK_CLOSE(0.40, ntg.iget(i, j, 0), 0.0001);
+        }
+    }
+}
+
+static Opm::Deck createOperateDeck() {
+    const char *deckData = "RUNSPEC\n"
+            "\n"
+            "DIMENS\n"
+            " 10 1 1 /\n"
+            "GRID\n"
+            "DX\n"
+            "10*0.25 /\n"
+            "DY\n"
+            "10*0.25 /\n"
+            "DZ\n"
+            "10*0.25 /\n"
+            "TOPS\n"
+            "10*0.25 /\n"
+            "PORO\n"
+            "10*0.25 /\n"
+            "NTG\n"
+            "10*1.0 /\n"
+            "OPERATE\n"
+            "  NTG   1  1 1 1 1 1  'MULTA'     PORO  2 0.5 /\n"
+            "  NTG   2  2 1 1 1 1  'POLY'      PORO  2 0.5 /\n"
+            "  NTG   3  3 1 1 1 1  'SLOG'      PORO  1 2 /\n"
+            "  NTG   4  4 1 1 1 1  'LOG10'     PORO /\n"
+            "  NTG   5  5 1 1 1 1  'LOGE'      PORO /\n"
+            "  NTG   6  6 1 1 1 1  'INV'       PORO /\n"
+            "  NTG   7  7 1 1 1 1  'MULTX'     PORO  3 /\n"
+            "  NTG   8  8 1 1 1 1  'ADDX'      PORO  3 /\n"
+            "  NTG   9  9 1 1 1 1  'MULTP'     PORO  2 0.5 /\n"
+            "  NTG  10 10 1 1 1 1  'MULTIPLY'  PORO /\n"
+            "/\n"
+            "\n";
+
+    Opm::Parser parser;
+    return parser.parseString(deckData, Opm::ParseContext() );
+}
+
+BOOST_AUTO_TEST_CASE(OperateFunctions) {
+    Setup s(createOperateDeck());
+    const auto& ntg = s.props.getDoubleGridProperty("NTG");
+    const std::vector< double > expected = { 1.0, 2.0, std::pow(10, 1.5), std::log10(0.25), std::log(0.25),
+                                             4.0, 0.75, 3.25, 1.0, 0.25 };
+
+    for (size_t i = 0; i < expected.size(); i++)
+        BOOST_CHECK_CLOSE(expected[i], ntg.iget(i, 0, 0), 0.0001);
+}
@@ -20,7 +20,11 @@
 #include <stdexcept>
 #include <iostream>
 #include <boost/filesystem.hpp>
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 
 #define BOOST_TEST_MODULE EclipseGridTests
 #include <boost/test/unit_test.hpp>
@@ -35,10 +39,21 @@
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
 
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 
+/*
+  The grid construction runs in parallel; force several threads before
+  the first parallel loop to exercise the threaded code paths also on
+  single core machines.
+*/
+struct ForceThreads {
+    ForceThreads() { setenv( "OPM_NUM_THREADS", "4", 1 ); }
+};
+
+BOOST_GLOBAL_FIXTURE( ForceThreads );
 
 BOOST_AUTO_TEST_CASE(CreateMissingDIMENS_throws) {
     Opm::Deck deck;
@@ -948,6 +963,7 @@ BOOST_AUTO_TEST_CASE(GridBoxActnum) {
                         BOOST_CHECK(grid.cellActive(x, y, z));
                         BOOST_CHECK_EQUAL( grid.activeIndex(x,y,z) , active_index );
                         BOOST_CHECK_EQUAL( grid.activeIndex(g) , active_index );
+                        BOOST_CHECK_EQUAL( grid.getGlobalIndex(active_index) , g );
 
                         active_index++;
                     }
@@ -956,6 +972,8 @@ BOOST_AUTO_TEST_CASE(GridBoxActnum) {
         }
 
         BOOST_CHECK_THROW( grid.activeIndex(0,0,0) , std::invalid_argument );
+        BOOST_CHECK_EQUAL( grid.getNumActive() , active_index );
+        BOOST_CHECK_THROW( grid.getGlobalIndex(active_index) , std::invalid_argument );
     }
 }
 
@@ -1395,3 +1413,532 @@ BOOST_AUTO_TEST_CASE(CoordMapper) {
 
     BOOST_CHECK_EQUAL( cmp.index(10,7,2,1) + 1 , cmp.size( ));
 }
+
+
+BOOST_AUTO_TEST_CASE(CellDimsDippingCell) {
+    /* A 3 x 2 x 1 cell dipping in the x direction; the top goes from z = 0 to z = 4. */
+    const Opm::GridGeometry::corners p = {{ {{ 0, 0, 0 }}, {{ 3, 0, 4 }}, {{ 0, 2, 0 }}, {{ 3, 2, 4 }},
+                                            {{ 0, 0, 1 }}, {{ 3, 0, 5 }}, {{ 0, 2, 1 }}, {{ 3, 2, 5 }} }};
+    const auto dims = Opm::GridGeometry::cellDims( p );
+
+    BOOST_CHECK_CLOSE( dims[0] , 3.0 , 1e-8 );
+    BOOST_CHECK_CLOSE( dims[1] , 2.0 , 1e-8 );
+    BOOST_CHECK_CLOSE( dims[2] , 1.0 , 1e-8 );
+}
+
+
+static void check_geometry( const Opm::EclipseGrid& grid ) {
+    const auto& geometry = grid.getGeometry();
+    BOOST_CHECK_EQUAL( geometry.size() , grid.getCartesianSize() );
+
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        const auto center = grid.getCellCenter( g );
+        const auto dims = grid.getCellDims( g );
+
+        BOOST_CHECK_CLOSE( geometry.getCenterX()[g] , center[0] , 1e-6 );
+        BOOST_CHECK_CLOSE( geometry.getCenterY()[g] , center[1] , 1e-6 );
+        BOOST_CHECK_CLOSE( geometry.getDepth()[g]   , grid.getCellDepth( g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( geometry.getVolume()[g]  , grid.getCellVolume( g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( geometry.getThickness()[g] , grid.getCellThicknes( g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( geometry.getDX()[g] , dims[0] , 1e-6 );
+        BOOST_CHECK_CLOSE( geometry.getDY()[g] , dims[1] , 1e-6 );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(GridGeometry) {
+    std::array<int,3> dims = {{ 4 , 3 , 5 }};
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+
+    for (int j = 0; j <= dims[1]; j++) {
+        for (int i = 0; i <= dims[0]; i++) {
+            coord.insert( coord.end() , { i + 0.10*j , 1.0*j , 0.0,
+                                          i + 0.10*j + 0.30 , j + 0.20 , 10.0 } );
+        }
+    }
+
+    Opm::ZcornMapper mapper( dims[0] , dims[1] , dims[2] );
+    zcorn.resize( mapper.size() );
+    for (int k = 0; k < dims[2]; k++) {
+        for (int j = 0; j < dims[1]; j++) {
+            for (int i = 0; i < dims[0]; i++) {
+                for (int c = 0; c < 4; c++) {
+                    double top = 2.0*k + 0.10*(i + (c & 1)) + 0.05*(j + (c >> 1));
+                    zcorn[ mapper.index( i,j,k,c ) ] = top;
+                    zcorn[ mapper.index( i,j,k,c + 4 ) ] = top + 1.5 + 0.05*c;
+                }
+            }
+        }
+    }
+
+    Opm::EclipseGrid grid( dims , coord , zcorn );
+    check_geometry( grid );
+
+    /* The geometry is cached */
+    BOOST_CHECK_EQUAL( &grid.getGeometry() , &grid.getGeometry() );
+
+    zcorn.pop_back();
+    BOOST_CHECK_THROW( Opm::GridGeometry( 4 , 3 , 5 , coord , zcorn ) , std::invalid_argument );
+
+    /*
+      A cell with a warped bottom face: the bottom of corner 7 is one
+      unit deeper, so the volume of the cell is 1.25. The volume must
+      not depend on how the non-planar face is split.
+    */
+    {
+        std::array<int,3> unit = {{ 1 , 1 , 1 }};
+        std::vector<double> warped_coord;
+        for (int j = 0; j <= 1; j++) {
+            for (int i = 0; i <= 1; i++)
+                warped_coord.insert( warped_coord.end() , { 1.0*i , 1.0*j , 0.0 , 1.0*i , 1.0*j , 10.0 } );
+        }
+        std::vector<double> warped_zcorn = { 0 , 0 , 0 , 0 , 1 , 1 , 1 , 2 };
+
+        Opm::EclipseGrid warped( unit , warped_coord , warped_zcorn );
+        check_geometry( warped );
+        BOOST_CHECK_CLOSE( warped.getGeometry().getVolume()[0] , 1.25 , 1e-8 );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(GridGeometryRadial) {
+    Opm::Deck deck = radial_details();
+    Opm::EclipseGrid grid( deck );
+    check_geometry( grid );
+}
+
+
+/*
+  Reference implementation of the ZCORN fixup: a plain serial pass over
+  the grid in natural order.
+*/
+static size_t serial_fixupZCORN( Opm::ZcornMapper& mapper , const std::array<size_t,3>& dims , std::vector<double>& zcorn ) {
+    int sign = zcorn[ mapper.index(0,0,0,0) ] <= zcorn[ mapper.index(0,0, dims[2] - 1,4) ] ? 1 : -1;
+    size_t adjusted = 0;
+
+    for (size_t k = 0; k < dims[2]; k++)
+        for (size_t j = 0; j < dims[1]; j++)
+            for (size_t i = 0; i < dims[0]; i++)
+                for (int c = 0; c < 4; c++) {
+                    if (k > 0) {
+                        size_t index1 = mapper.index(i,j,k-1,c+4);
+                        size_t index2 = mapper.index(i,j,k,c);
+                        if ((zcorn[index2] - zcorn[index1]) * sign < 0) {
+                            zcorn[index2] = zcorn[index1];
+                            adjusted++;
+                        }
+                    }
+
+                    size_t index1 = mapper.index(i,j,k,c);
+                    size_t index2 = mapper.index(i,j,k,c+4);
+                    if ((zcorn[index2] - zcorn[index1]) * sign < 0) {
+                        zcorn[index2] = zcorn[index1];
+                        adjusted++;
+                    }
+                }
+
+    return adjusted;
+}
+
+
+BOOST_AUTO_TEST_CASE(ParallelFixupZCORN) {
+    const std::array<size_t,3> dims = {{ 40 , 30 , 6 }};
+    Opm::ZcornMapper mapper( dims[0] , dims[1] , dims[2] );
+    std::vector<double> zcorn( mapper.size() );
+
+    /* Deterministic noise which creates plenty of overlapping cells. */
+    for (size_t g = 0; g < zcorn.size(); g++)
+        zcorn[g] = (g / (4 * dims[0] * dims[1])) + 0.75 * std::sin( 0.37 * g );
+
+    std::vector<double> expected = zcorn;
+    size_t expected_adjusted = serial_fixupZCORN( mapper , dims , expected );
+    BOOST_CHECK( expected_adjusted > 0 );
+
+    BOOST_CHECK_EQUAL( mapper.fixupZCORN( zcorn ) , expected_adjusted );
+    BOOST_CHECK( zcorn == expected );
+    BOOST_CHECK( mapper.validZCORN( zcorn ));
+}
+
+
+BOOST_AUTO_TEST_CASE(ParallelActiveMap) {
+    /* Large enough to be numbered in several blocks */
+    Opm::EclipseGrid grid( 80 , 50 , 10 );
+    std::vector<int> actnum( grid.getCartesianSize() , 1 );
+    for (size_t g = 0; g < actnum.size(); g++)
+        if ((g % 7) == 0 || (g % 11) == 3)
+            actnum[g] = 0;
+
+    grid.resetACTNUM( actnum.data() );
+    const auto& active_map = grid.getActiveMap();
+    BOOST_CHECK_EQUAL( active_map.size() , grid.getNumActive() );
+
+    size_t active_index = 0;
+    for (size_t g = 0; g < actnum.size(); g++) {
+        if (actnum[g]) {
+            BOOST_CHECK_EQUAL( active_map[active_index] , int(g) );
+            BOOST_CHECK_EQUAL( grid.activeIndex( g ) , active_index );
+            active_index++;
+        }
+    }
+    BOOST_CHECK_EQUAL( active_index , grid.getNumActive() );
+
+    {
+        std::vector<double> coord;
+        std::vector<double> zcorn;
+        std::array<int,3> dims = grid.getNXYZ();
+
+        grid.exportCOORD( coord );
+        grid.exportZCORN( zcorn );
+
+        Opm::EclipseGrid grid2( dims , coord , zcorn , actnum.data() );
+        BOOST_CHECK( grid.equal( grid2 ));
+        BOOST_CHECK( grid.getActiveMap() == grid2.getActiveMap() );
+        BOOST_CHECK( grid.getGlobalToActiveMap() == grid2.getGlobalToActiveMap() );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(CompressExpand) {
+    Opm::EclipseGrid grid( 50 , 40 , 20 );
+    std::vector<int> actnum( grid.getCartesianSize() , 1 );
+    for (size_t g = 0; g < actnum.size(); g += 3)
+        actnum[g] = 0;
+
+    grid.resetACTNUM( actnum.data() );
+    const auto& global_to_active = grid.getGlobalToActiveMap();
+    BOOST_CHECK_EQUAL( global_to_active.size() , grid.getCartesianSize() );
+
+    std::vector<double> global_data( grid.getCartesianSize() );
+    for (size_t g = 0; g < global_data.size(); g++)
+        global_data[g] = 1.5 * g;
+
+    std::vector<double> active_data( grid.getNumActive() );
+    grid.compress( global_data.data() , active_data.data() );
+    BOOST_CHECK( active_data == grid.compressedVector( global_data ));
+
+    for (size_t g = 0; g < global_data.size(); g++) {
+        if (actnum[g]) {
+            BOOST_CHECK_EQUAL( global_to_active[g] , int(grid.activeIndex( g )) );
+            BOOST_CHECK_EQUAL( active_data[ global_to_active[g] ] , 1.5 * g );
+        } else {
+            BOOST_CHECK_EQUAL( global_to_active[g] , -1 );
+            BOOST_CHECK( !grid.cellActive( g ));
+        }
+    }
+
+    std::vector<double> expanded( grid.getCartesianSize() , -1 );
+    grid.expand( active_data.data() , expanded.data() );
+    for (size_t g = 0; g < expanded.size(); g++)
+        BOOST_CHECK_EQUAL( expanded[g] , actnum[g] ? 1.5 * g : -1 );
+
+    BOOST_CHECK_THROW( grid.activeIndex( 0 ) , std::invalid_argument );
+    BOOST_CHECK_THROW( grid.activeIndex( grid.getCartesianSize() ) , std::invalid_argument );
+}
+
+
+static void check_cartesian_geometry( const Opm::EclipseGrid& grid ) {
+    /*
+      The geometry of the cartesian grids is computed without ERT; the
+      ERT grid from c_ptr() is created on demand and should agree.
+    */
+    const ecl_grid_type * ecl_grid = grid.c_ptr();
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        double x,y,z;
+        ecl_grid_get_xyz1( ecl_grid , g , &x , &y , &z );
+        const auto center = grid.getCellCenter( g );
+
+        BOOST_CHECK_CLOSE( center[0] , x , 1e-6 );
+        BOOST_CHECK_CLOSE( center[1] , y , 1e-6 );
+        BOOST_CHECK_CLOSE( center[2] , z , 1e-6 );
+        BOOST_CHECK_CLOSE( grid.getCellDepth( g ) , ecl_grid_get_cdepth1( ecl_grid , g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( grid.getCellVolume( g ) , ecl_grid_get_cell_volume1( ecl_grid , g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( grid.getCellThicknes( g ) , ecl_grid_get_cell_thickness1( ecl_grid , g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( grid.getCellDims( g )[0] , ecl_grid_get_cell_dx1( ecl_grid , g ) , 1e-6 );
+        BOOST_CHECK_CLOSE( grid.getCellDims( g )[1] , ecl_grid_get_cell_dy1( ecl_grid , g ) , 1e-6 );
+        BOOST_CHECK_EQUAL( grid.cellActive( g ) , ecl_grid_cell_active1( ecl_grid , g ));
+    }
+
+    {
+        std::vector<double> coord( ecl_grid_get_coord_size( ecl_grid ));
+        std::vector<double> zcorn( ecl_grid_get_zcorn_size( ecl_grid ));
+        std::vector<double> export_coord;
+        std::vector<double> export_zcorn;
+
+        ecl_grid_init_coord_data_double( ecl_grid , coord.data() );
+        ecl_grid_init_zcorn_data_double( ecl_grid , zcorn.data() );
+        grid.zcornMapper().fixupZCORN( zcorn );
+
+        grid.exportCOORD( export_coord );
+        grid.exportZCORN( export_zcorn );
+        BOOST_CHECK( coord == export_coord );
+        BOOST_CHECK( zcorn == export_zcorn );
+    }
+
+    BOOST_CHECK_EQUAL( grid.getNumActive() , size_t( ecl_grid_get_nactive( ecl_grid )));
+    check_geometry( grid );
+}
+
+
+BOOST_AUTO_TEST_CASE(ImplicitCartesianGrid) {
+    const char* dtops =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        "4 3 2 /\n"
+        "GRID\n"
+        "DX\n"
+        "1 2 3 4 2 2 2 2 1 1 3 3 /\n"
+        "DY\n"
+        "12*1.5 /\n"
+        "DZ\n"
+        "12*2 12*3 /\n"
+        "TOPS\n"
+        "1 2 3 4 5 6 7 8 9 10 11 12 /\n";
+
+    const char* dvdepthz =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        "3 2 2 /\n"
+        "GRID\n"
+        "DXV\n"
+        "1 2 3 /\n"
+        "DYV\n"
+        "4 5 /\n"
+        "DZV\n"
+        "2 3 /\n"
+        "DEPTHZ\n"
+        "12*10 /\n";
+
+    Opm::Parser parser;
+    for (const auto* input : { dtops , dvdepthz }) {
+        Opm::EclipseGrid grid( parser.parseString( input , Opm::ParseContext() ));
+        check_cartesian_geometry( grid );
+    }
+
+    {
+        /* Every DTOPS cell is a DX*DY*DZ box, also when DX varies with j. */
+        Opm::EclipseGrid grid( parser.parseString( dtops , Opm::ParseContext() ));
+        const double dx[] = { 1 , 2 , 3 , 4 , 2 , 2 , 2 , 2 , 1 , 1 , 3 , 3 };
+        for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+            const double dz = g < 12 ? 2 : 3;
+            const auto dims = grid.getCellDims( g );
+            BOOST_CHECK_CLOSE( dims[0] , dx[g % 12] , 1e-8 );
+            BOOST_CHECK_CLOSE( dims[1] , 1.5 , 1e-8 );
+            BOOST_CHECK_CLOSE( dims[2] , dz , 1e-8 );
+            BOOST_CHECK_CLOSE( grid.getCellVolume( g ) , dx[g % 12] * 1.5 * dz , 1e-8 );
+        }
+        BOOST_CHECK_CLOSE( grid.getCellCenter( 4 )[0] , 1.0 , 1e-8 );
+        BOOST_CHECK_CLOSE( grid.getCellCenter( 4 )[1] , 2.25 , 1e-8 );
+    }
+
+    {
+        Opm::EclipseGrid grid( parser.parseString( dtops , Opm::ParseContext() ));
+        std::vector<int> actnum( grid.getCartesianSize() , 1 );
+        actnum[2] = 0;
+        actnum[17] = 0;
+        grid.resetACTNUM( actnum.data() );
+
+        BOOST_CHECK_EQUAL( grid.getNumActive() , grid.getCartesianSize() - 2 );
+        BOOST_CHECK( !grid.cellActive( 17 ));
+
+        std::vector<int> export_actnum;
+        grid.exportACTNUM( export_actnum );
+        BOOST_CHECK( actnum == export_actnum );
+
+        /* The copy shares the geometry, and has its own ERT grid. */
+        Opm::EclipseGrid copy( grid );
+        check_cartesian_geometry( copy );
+        check_cartesian_geometry( grid );
+        BOOST_CHECK( grid.equal( copy ));
+    }
+
+    {
+        Opm::EclipseGrid grid( 10 , 5 , 3 , 0.5 , 2 , 4 );
+        check_cartesian_geometry( grid );
+        BOOST_CHECK_CLOSE( grid.getCellVolume( 3 , 2 , 1 ) , 0.5 * 2 * 4 , 1e-8 );
+    }
+}
+
+
+static void check_find_cell( const Opm::EclipseGrid& grid ) {
+    std::vector< std::array< double, 3 > > points;
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        const auto center = grid.getCellCenter( g );
+        BOOST_CHECK_EQUAL( grid.findCell( center[0] , center[1] , center[2] ) , int( g ));
+        points.push_back( center );
+    }
+
+    const auto& geometry = grid.getGeometry();
+    double xmax = geometry.getCenterX()[0];
+    double zmin = geometry.getDepth()[0];
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        xmax = std::max( xmax , geometry.getCenterX()[g] );
+        zmin = std::min( zmin , geometry.getDepth()[g] );
+    }
+
+    const std::array< double, 3 > outside_xy = {{ xmax + 1000 , 0 , zmin }};
+    const std::array< double, 3 > above = {{ points[0][0] , points[0][1] , zmin - 1000 }};
+    BOOST_CHECK_EQUAL( grid.findCell( outside_xy[0] , outside_xy[1] , outside_xy[2] ) , -1 );
+    BOOST_CHECK_EQUAL( grid.findCell( above[0] , above[1] , above[2] ) , -1 );
+    points.push_back( outside_xy );
+    points.push_back( above );
+
+    const auto cells = grid.findCells( points );
+    BOOST_CHECK_EQUAL( cells.size() , points.size() );
+    for (size_t n = 0; n < points.size(); n++)
+        BOOST_CHECK_EQUAL( cells[n] , grid.findCell( points[n][0] , points[n][1] , points[n][2] ));
+}
+
+
+BOOST_AUTO_TEST_CASE(FindCell) {
+    std::array<int,3> dims = {{ 4 , 3 , 5 }};
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+
+    for (int j = 0; j <= dims[1]; j++) {
+        for (int i = 0; i <= dims[0]; i++) {
+            coord.insert( coord.end() , { i + 0.10*j , 1.0*j , 0.0,
+                                          i + 0.10*j + 0.30 , j + 0.20 , 10.0 } );
+        }
+    }
+
+    Opm::ZcornMapper mapper( dims[0] , dims[1] , dims[2] );
+    zcorn.resize( mapper.size() );
+    for (int k = 0; k < dims[2]; k++) {
+        for (int j = 0; j < dims[1]; j++) {
+            for (int i = 0; i < dims[0]; i++) {
+                for (int c = 0; c < 4; c++) {
+                    double top = 2.0*k + 0.10*(i + (c & 1)) + 0.05*(j + (c >> 1));
+                    zcorn[ mapper.index( i,j,k,c ) ] = top;
+                    zcorn[ mapper.index( i,j,k,c + 4 ) ] = top + 1.5 + 0.05*c;
+                }
+            }
+        }
+    }
+
+    Opm::EclipseGrid grid( dims , coord , zcorn );
+    check_find_cell( grid );
+
+    /* The layers are separated by a gap of about 0.5 */
+    const auto top = grid.getCellCenter( 1 , 1 , 1 );
+    BOOST_CHECK_EQUAL( grid.findCell( top[0] , top[1] , top[2] + 1.1 ) , -1 );
+}
+
+
+BOOST_AUTO_TEST_CASE(FindCellCartesian) {
+    Opm::EclipseGrid grid( 10 , 5 , 3 , 0.5 , 2 , 4 );
+    check_find_cell( grid );
+
+    BOOST_CHECK_EQUAL( grid.findCell( 0.26 , 3.1 , 9 ) , 110 );
+    BOOST_CHECK_EQUAL( grid.findCell( 4.99 , 9.99 , 11.99 ) , int( grid.getCartesianSize() - 1 ));
+    BOOST_CHECK_EQUAL( grid.findCell( 5.01 , 9.99 , 11.99 ) , -1 );
+}
+
+
+namespace {
+
+    std::string be32( uint32_t value ) {
+        const char bytes[4] = { char( value >> 24 ), char( value >> 16 ), char( value >> 8 ), char( value ) };
+        return std::string( bytes, 4 );
+    }
+
+    void write_record( std::ostream& stream, const std::string& data ) {
+        stream << be32( data.size() ) << data << be32( data.size() );
+    }
+
+    void write_keyword( std::ostream& stream, std::string name, const std::string& type,
+                        size_t count, const std::string& data ) {
+        name.resize( 8, ' ' );
+        write_record( stream, name + be32( count ) + type );
+        if( count > 0 )
+            write_record( stream, data );
+    }
+
+    /* A minimal binary EGRID file with the geometry and ACTNUM of the grid */
+    void write_egrid( const std::string& filename, const Opm::EclipseGrid& grid ) {
+        std::vector< double > coord, zcorn;
+        std::vector< int > actnum;
+        grid.exportCOORD( coord );
+        grid.exportZCORN( zcorn );
+        grid.exportACTNUM( actnum );
+
+        const auto floats = []( const std::vector< double >& values ) {
+            std::string data;
+            for( double value : values ) {
+                const float f = value;
+                uint32_t bits;
+                std::memcpy( &bits, &f, sizeof( bits ));
+                data += be32( bits );
+            }
+            return data;
+        };
+
+        std::string gridhead = be32( 1 ) + be32( grid.getNX() ) + be32( grid.getNY() ) + be32( grid.getNZ() );
+        for( int i = 4; i < 100; i++ )
+            gridhead += be32( 0 );
+
+        std::string actnum_data;
+        for( int a : actnum )
+            actnum_data += be32( a );
+
+        std::ofstream stream( filename, std::ios::binary );
+        write_keyword( stream, "GRIDHEAD", "INTE", 100, gridhead );
+        write_keyword( stream, "COORD", "REAL", coord.size(), floats( coord ));
+        write_keyword( stream, "ZCORN", "REAL", zcorn.size(), floats( zcorn ));
+        write_keyword( stream, "ACTNUM", "INTE", actnum.size(), actnum_data );
+        write_keyword( stream, "ENDGRID", "INTE", 0, "" );
+    }
+
+    Opm::Deck createGDFILEDeck( const std::string& filename, const std::string& dimens, const std::string& actnum ) {
+        const std::string deckData =
+            "RUNSPEC\n"
+            "DIMENS\n"
+            " " + dimens + " /\n"
+            "GRID\n"
+            "GDFILE\n"
+            " '" + filename + "' /\n"
+            + actnum +
+            "PORO\n"
+            " 12*0.25 /\n"
+            "EDIT\n"
+            "\n";
+
+        Opm::Parser parser;
+        return parser.parseString( deckData, Opm::ParseContext() );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(GDFILE) {
+    namespace fs = boost::filesystem;
+    const auto dir = fs::temp_directory_path() / fs::unique_path( "gdfile-%%%%-%%%%" );
+    fs::create_directories( dir );
+    const auto root = ( dir / "GRIDFILE" ).string();
+
+    Opm::EclipseGrid source( 3 , 2 , 2 , 1.0 , 2.0 , 3.0 );
+    std::vector< int > actnum( source.getCartesianSize() , 1 );
+    actnum[4] = 0;
+    source.resetACTNUM( actnum.data() );
+    write_egrid( root + ".EGRID", source );
+
+    {
+        Opm::EclipseState es( createGDFILEDeck( root + ".EGRID" , "3 2 2" , "" ), Opm::ParseContext() );
+        const auto& grid = es.getInputGrid();
+        BOOST_CHECK( grid.equal( source ));
+        BOOST_CHECK_EQUAL( grid.getNumActive() , 11U );
+        BOOST_CHECK_CLOSE( grid.getCellVolume( 7 ) , 6.0 , 1e-4 );
+        BOOST_CHECK_EQUAL( es.get3DProperties().getDoubleGridProperty( "PORO" ).iget( 7 ) , 0.25 );
+    }
+
+    /* The extension can be omitted, and ACTNUM from the deck is applied. */
+    {
+        Opm::EclipseGrid grid( createGDFILEDeck( root , "3 2 2" , "ACTNUM\n 12*1 /\n" ));
+        BOOST_CHECK_EQUAL( grid.getNumActive() , 12U );
+        BOOST_CHECK_CLOSE( grid.getCellVolume( 4 ) , 6.0 , 1e-4 );
+    }
+
+    BOOST_CHECK_THROW( Opm::EclipseGrid( createGDFILEDeck( root , "3 2 3" , "" )) , std::invalid_argument );
+    BOOST_CHECK_THROW( Opm::EclipseGrid( createGDFILEDeck( root + "-missing" , "3 2 2" , "" )) , std::invalid_argument );
+
+    fs::remove_all( dir );
+}
@@ -650,3 +650,64 @@ BOOST_AUTO_TEST_CASE(TestIOConfigCreationWithSolutionRPTSOL) {
         BOOST_CHECK_EQUAL(true, rstConfig.getWriteRestartFile(0));
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(ActiveCellsOnly) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 3 2 /\n"
+        "GRID\n"
+        "DX\n"
+        "18*0.25 /\n"
+        "DY\n"
+        "18*0.25 /\n"
+        "DZ\n"
+        "18*0.25 /\n"
+        "TOPS\n"
+        "9*0.25 /\n"
+        "ACTNUM\n"
+        " 0 1 1 1 0 1 1 1 1 9*1 /\n"
+        "PORO\n"
+        " 9*0.10 9*0.20 /\n"
+        "PERMX\n"
+        " 18*100 /\n"
+        "MULTNUM\n"
+        " 9*1 9*2 /\n"
+        "MULTREGT\n"
+        " 1 2 0.5 Z 1* M /\n"
+        "/\n"
+        "REGIONS\n"
+        "SATNUM\n"
+        " 9*1 9*2 /\n";
+
+    Parser parser;
+    auto deck = parser.parseString( deckData, ParseContext() );
+    EclipseState full( deck, ParseContext() );
+    EclipseState compressed( deck, ParseContext(), EclipseState::PropertyStorage::ActiveCells );
+    const auto& grid = compressed.getInputGrid();
+    BOOST_CHECK_EQUAL( grid.getNumActive(), 16U );
+
+    for (const auto* keyword : { "PORO", "PERMX", "PORV" }) {
+        const auto& property = compressed.get3DProperties().getDoubleGridProperty( keyword );
+        const auto& fullProperty = full.get3DProperties().getDoubleGridProperty( keyword );
+
+        BOOST_CHECK( property.getStorage() == GridProperty<double>::Storage::Compressed );
+        BOOST_CHECK( property.compressedCopy( grid ) == fullProperty.compressedCopy( full.getInputGrid() ));
+    }
+
+    const auto& satnum = compressed.get3DProperties().getIntGridProperty( "SATNUM" );
+    BOOST_CHECK( satnum.getStorage() == GridProperty<int>::Storage::Compressed );
+    BOOST_CHECK_EQUAL( satnum.iget( 17 ), 2 );
+
+    const auto& actnum = compressed.get3DProperties().getIntGridProperty( "ACTNUM" );
+    BOOST_CHECK( actnum.getStorage() != GridProperty<int>::Storage::Compressed );
+    BOOST_CHECK_EQUAL( actnum.iget( 4 ), 0 );
+
+    /* The MULTREGT multipliers read the compressed MULTNUM without expanding it */
+    const auto& multnum = compressed.get3DProperties().getIntGridProperty( "MULTNUM" );
+    BOOST_CHECK( multnum.getStorage() == GridProperty<int>::Storage::Compressed );
+    BOOST_CHECK_EQUAL( compressed.getTransMult().getRegionMultiplier( 1, 10, FaceDir::ZPlus ), 0.5 );
+    BOOST_CHECK_EQUAL( compressed.getTransMult().getRegionMultipliers( FaceDir::ZPlus )[ 1 ], 0.5 );
+    BOOST_CHECK( multnum.getStorage() == GridProperty<int>::Storage::Compressed );
+}
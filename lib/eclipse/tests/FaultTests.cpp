@@ -138,3 +138,28 @@ BOOST_AUTO_TEST_CASE(AddFaultsToCollection) {
     BOOST_CHECK(faults.hasFault("FAULTX"));
     BOOST_CHECK_EQUAL( faultx.getName() , faults.getFault(1).getName());
 }
+
+
+BOOST_AUTO_TEST_CASE(FaceRange) {
+    Opm::FaultFace face( 4 , 3 , 5 , 1 , 1 , 0 , 2 , 1 , 3 , Opm::FaceDir::XPlus );
+    BOOST_CHECK_EQUAL( face.size() , 9U );
+    BOOST_CHECK_EQUAL( face.getI1() , 1U );
+    BOOST_CHECK_EQUAL( face.getJ2() , 2U );
+    BOOST_CHECK_EQUAL( face.getK1() , 1U );
+    BOOST_CHECK_EQUAL( face.getK2() , 3U );
+
+    std::vector< size_t > indices;
+    for (size_t k = 1; k <= 3; k++)
+        for (size_t j = 0; j <= 2; j++)
+            indices.push_back( 1 + 4 * ( j + 3 * k ));
+
+    std::vector< size_t > face_indices( face.begin() , face.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( face_indices.begin() , face_indices.end() , indices.begin() , indices.end() );
+
+    Opm::FaultFace same( 4 , 3 , 5 , 1 , 1 , 0 , 2 , 1 , 3 , Opm::FaceDir::XPlus );
+    Opm::FaultFace other_dir( 4 , 3 , 5 , 1 , 1 , 0 , 2 , 1 , 3 , Opm::FaceDir::XMinus );
+    Opm::FaultFace other_range( 4 , 3 , 5 , 1 , 1 , 0 , 2 , 1 , 2 , Opm::FaceDir::XPlus );
+    BOOST_CHECK( face == same );
+    BOOST_CHECK( face != other_dir );
+    BOOST_CHECK( face != other_range );
+}
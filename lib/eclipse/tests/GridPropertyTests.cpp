@@ -17,6 +17,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <memory>
@@ -37,6 +38,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/Box.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/RegionIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
 static const Opm::DeckKeyword createSATNUMKeyword( ) {
@@ -555,3 +557,358 @@ BOOST_AUTO_TEST_CASE(hasKeyword_assertKeyword) {
 
     BOOST_CHECK_THROW( gridProperties.getKeyword( "NOT-SUPPORTED" ), std::invalid_argument );
 }
+
+
+static void check_ranges( const Opm::GridProperty<int>& prop ) {
+    size_t next = 0;
+    int previous = 0;
+    prop.forEachRange( [&]( size_t begin, size_t end, int value ) {
+            BOOST_CHECK_EQUAL( begin , next );
+            BOOST_CHECK( begin < end );
+            if (begin > 0)
+                BOOST_CHECK( value != previous );
+
+            for (size_t g = begin; g < end; g++)
+                BOOST_CHECK_EQUAL( prop.iget( g ) , value );
+
+            next = end;
+            previous = value;
+        } );
+    BOOST_CHECK_EQUAL( next , prop.getCartesianSize() );
+}
+
+
+BOOST_AUTO_TEST_CASE(StorageForms) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    typedef Opm::GridProperty<int>::Storage Storage;
+    SupportedKeywordInfo keywordInfo( "P1", 1, "1" );
+    Opm::GridProperty<int> prop( 4, 4, 2, keywordInfo );
+
+    Opm::Box global( 4, 4, 2 );
+    Opm::Box layer0( global, 0, 3, 0, 3, 0, 0 );
+    Opm::Box corner( global, 0, 1, 0, 1, 1, 1 );
+    Opm::Box column( global, 2, 2, 2, 2, 0, 1 );
+
+    /* Uniform operations keep a single value */
+    BOOST_CHECK( prop.getStorage() == Storage::Constant );
+    prop.scale( 3, global );
+    prop.add( 1, global );
+    prop.iset( 5, 4 );
+    BOOST_CHECK( prop.getStorage() == Storage::Constant );
+    BOOST_CHECK_EQUAL( prop.iget( 31 ), 4 );
+    check_ranges( prop );
+
+    /* Box operations where the box has one value are recorded as boxes */
+    prop.setScalar( 7, layer0 );
+    prop.add( 1, layer0 );
+    prop.scale( 2, corner );
+    BOOST_CHECK( prop.getStorage() == Storage::Boxes );
+    BOOST_CHECK_EQUAL( prop.iget( 1, 1, 0 ), 8 );
+    BOOST_CHECK_EQUAL( prop.iget( 1, 1, 1 ), 8 );
+    BOOST_CHECK_EQUAL( prop.iget( 3, 3, 1 ), 4 );
+    BOOST_CHECK_EQUAL( prop.indexEqual( 8 ).size(), 20U );
+    check_ranges( prop );
+
+    std::vector< bool > mask;
+    prop.initMask( 4, mask );
+    BOOST_CHECK_EQUAL( std::count( mask.begin(), mask.end(), true ), 12 );
+    BOOST_CHECK( prop.getStorage() == Storage::Boxes );
+
+    /* ... and a value which varies over the box makes the property dense */
+    Opm::GridProperty<int> copy( prop );
+    copy.scale( 3, column );
+    BOOST_CHECK( copy.getStorage() == Storage::Dense );
+    BOOST_CHECK_EQUAL( copy.iget( 2, 2, 0 ), 24 );
+    BOOST_CHECK_EQUAL( copy.iget( 2, 2, 1 ), 12 );
+    BOOST_CHECK_EQUAL( copy.iget( 1, 1, 1 ), 8 );
+    check_ranges( copy );
+
+    prop.iset( 0, 8 );
+    BOOST_CHECK( prop.getStorage() == Storage::Boxes );
+    prop.iset( 0, 9 );
+    BOOST_CHECK( prop.getStorage() == Storage::Dense );
+    BOOST_CHECK_EQUAL( prop.iget( 0 ), 9 );
+    BOOST_CHECK_EQUAL( prop.iget( 1, 1, 1 ), 8 );
+    BOOST_CHECK_EQUAL( prop.iget( 3, 3, 1 ), 4 );
+    check_ranges( prop );
+
+    prop.setScalar( 2, global );
+    BOOST_CHECK( prop.getStorage() == Storage::Constant );
+
+    /* getData() gives the full array */
+    const auto& data = copy.getData();
+    BOOST_CHECK_EQUAL( data.size(), copy.getCartesianSize() );
+    BOOST_CHECK_EQUAL( data[ 2 + 2*4 ], 24 );
+    prop.getData();
+    BOOST_CHECK( prop.getStorage() == Storage::Dense );
+}
+
+
+BOOST_AUTO_TEST_CASE(AutoCreatedConstant) {
+    typedef Opm::GridProperties<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    typedef Opm::GridProperty<int>::Storage Storage;
+    std::vector<SupportedKeywordInfo> supportedKeywords = {
+        SupportedKeywordInfo("SATNUM" , 1, "1"),
+        SupportedKeywordInfo("FIPNUM" , [](size_t size) { return std::vector<int>( size, 2 ); }, "1")
+    };
+    const Opm::EclipseGrid grid(20, 20, 20);
+    const Opm::GridProperties<int> gridProperties( grid, std::move( supportedKeywords ));
+
+    BOOST_CHECK( gridProperties.getKeyword( "SATNUM" ).getStorage() == Storage::Constant );
+    BOOST_CHECK( gridProperties.getKeyword( "FIPNUM" ).getStorage() == Storage::Dense );
+    BOOST_CHECK_EQUAL( gridProperties.getKeyword( "SATNUM" ).iget( 7999 ), 1 );
+    BOOST_CHECK_EQUAL( gridProperties.getKeyword( "SATNUM" ).compressedCopy( grid ).size(), 8000U );
+}
+
+
+BOOST_AUTO_TEST_CASE(CompressToActive) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    typedef Opm::GridProperty<int>::Storage Storage;
+    SupportedKeywordInfo keywordInfo( "P1", 1, "1" );
+    Opm::GridProperty<int> prop( 4, 4, 2, keywordInfo );
+    Opm::GridProperty<int> constant( 4, 4, 2, keywordInfo );
+
+    /* every third cell is inactive */
+    Opm::EclipseGrid grid( 4, 4, 2 );
+    std::vector< int > actnum( 32, 1 );
+    for (size_t g = 0; g < actnum.size(); g += 3)
+        actnum[g] = 0;
+    grid.resetACTNUM( actnum.data() );
+
+    const auto globalToActive = std::make_shared< const std::vector< int > >( grid.getGlobalToActiveMap() );
+    for (size_t g = 0; g < 32; g++)
+        prop.iset( g, int( g ));
+
+    prop.compressToActive( globalToActive, grid.getNumActive() );
+    constant.compressToActive( globalToActive, grid.getNumActive() );
+    BOOST_CHECK( prop.getStorage() == Storage::Compressed );
+    BOOST_CHECK( constant.getStorage() == Storage::Constant );
+
+    /* the inactive cells get the default value, and ignore writes */
+    for (size_t g = 0; g < 32; g++)
+        BOOST_CHECK_EQUAL( prop.iget( g ), g % 3 == 0 ? 1 : int( g ));
+
+    Opm::Box global( 4, 4, 2 );
+    Opm::Box layer1( global, 0, 3, 0, 3, 1, 1 );
+    prop.add( 100, layer1 );
+    prop.iset( 0, 77 );
+    prop.iset( 1, 78 );
+    BOOST_CHECK( prop.getStorage() == Storage::Compressed );
+    BOOST_CHECK_EQUAL( prop.iget( 0 ), 1 );
+    BOOST_CHECK_EQUAL( prop.iget( 1 ), 78 );
+    BOOST_CHECK_EQUAL( prop.iget( 17 ), 117 );
+    BOOST_CHECK_EQUAL( prop.iget( 18 ), 1 );
+
+    std::vector< int > expected;
+    for (size_t g = 0; g < 32; g++) {
+        if (grid.cellActive( g ))
+            expected.push_back( prop.iget( g ));
+    }
+    BOOST_CHECK( prop.compressedCopy( grid ) == expected );
+    BOOST_CHECK( prop.cellsEqual( 117, grid ) == std::vector< size_t >( 1, 11 ));
+
+    /* getData() gives the full size array back */
+    const auto& data = prop.getData();
+    BOOST_CHECK( prop.getStorage() == Storage::Dense );
+    BOOST_CHECK_EQUAL( data.size(), 32U );
+    BOOST_CHECK_EQUAL( data[17], 117 );
+    BOOST_CHECK_EQUAL( data[18], 1 );
+    BOOST_CHECK( prop.compressedCopy( grid ) == expected );
+}
+
+
+BOOST_AUTO_TEST_CASE(RegionIndexOperations) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo regionInfo( "FLUXNUM", 1, "1" );
+    SupportedKeywordInfo targetInfo( "P1", 0, "1" );
+    Opm::GridProperty<int> regions( 4, 3, 2, regionInfo );
+    Opm::GridProperty<int> target( 4, 3, 2, targetInfo );
+
+    /* region 3 in the second layer, and region 2 in every third cell */
+    Opm::Box global( 4, 3, 2 );
+    regions.setScalar( 3, Opm::Box( global, 0, 3, 0, 2, 1, 1 ));
+    for (size_t g = 0; g < 24; g += 3)
+        regions.iset( g, 2 );
+
+    const auto index = regions.regionIndex();
+    BOOST_CHECK_EQUAL( index->minRegion(), 1 );
+    BOOST_CHECK_EQUAL( index->maxRegion(), 3 );
+    BOOST_CHECK_EQUAL( index->numCells( 4 ), 0U );
+    BOOST_CHECK( index->cells( 0 ).empty() );
+    BOOST_CHECK( regions.regionIndex() == index );
+
+    size_t total = 0;
+    for (int region = 1; region <= 3; region++) {
+        const auto cells = index->cells( region );
+        BOOST_CHECK( cells == regions.indexEqual( region ));
+        total += cells.size();
+    }
+    BOOST_CHECK_EQUAL( total, 24U );
+
+    target.regionSet( 5, *index, 2 );
+    target.regionAdd( 1, *index, 3 );
+    target.regionMultiply( 4, *index, 3 );
+    for (size_t g = 0; g < 24; g++) {
+        const int region = regions.iget( g );
+        BOOST_CHECK_EQUAL( target.iget( g ), region == 2 ? 5 : region == 3 ? 4 : 0 );
+    }
+
+    /* modifying the region property gives a new index */
+    regions.regionSet( 7, *index, 2 );
+    BOOST_CHECK( regions.regionIndex() != index );
+    BOOST_CHECK_EQUAL( regions.regionIndex()->numCells( 7 ), 8U );
+    BOOST_CHECK_EQUAL( index->numCells( 2 ), 8U );
+
+    target.regionCopy( regions, *regions.regionIndex(), 7 );
+    BOOST_CHECK_EQUAL( target.iget( 0 ), 7 );
+    BOOST_CHECK_EQUAL( target.iget( 1 ), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE(RegionIndexSparseRegions) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    SupportedKeywordInfo regionInfo( "FIPNUM", 1, "1" );
+    Opm::GridProperty<int> regions( 3, 1, 1, regionInfo );
+    regions.iset( 1, 2000000000 );
+    regions.iset( 2, -1000000 );
+
+    /* The index is sized by the number of regions, not by their values */
+    const auto index = regions.regionIndex();
+    BOOST_CHECK_EQUAL( index->minRegion(), -1000000 );
+    BOOST_CHECK_EQUAL( index->maxRegion(), 2000000000 );
+    BOOST_CHECK( index->regions() == std::vector< int >( { -1000000, 1, 2000000000 } ));
+    BOOST_CHECK( index->cells( 2000000000 ) == std::vector< size_t >{ 1 } );
+    BOOST_CHECK( index->cells( 1 ) == std::vector< size_t >{ 0 } );
+    BOOST_CHECK_EQUAL( index->numCells( 2 ), 0U );
+    BOOST_CHECK_EQUAL( index->region( 2 ), -1000000 );
+}
+
+
+BOOST_AUTO_TEST_CASE(LookupStorage) {
+    typedef Opm::GridProperty<int>::SupportedKeywordInfo RegionKeywordInfo;
+    typedef Opm::GridProperty<double>::SupportedKeywordInfo SupportedKeywordInfo;
+    typedef Opm::GridProperty<double>::Storage Storage;
+    RegionKeywordInfo regionInfo( "SATNUM", 1, "1" );
+    Opm::GridProperty<int> regions( 4, 3, 2, regionInfo );
+
+    /* table 2 in the second layer, and table 3 in every fifth cell */
+    Opm::Box global( 4, 3, 2 );
+    regions.setScalar( 2, Opm::Box( global, 0, 3, 0, 2, 1, 1 ));
+    for (size_t g = 0; g < 24; g += 5)
+        regions.iset( g, 3 );
+
+    const auto index = regions.regionIndex();
+    for (size_t g = 0; g < 24; g++)
+        BOOST_CHECK_EQUAL( index->region( g ), regions.iget( g ));
+    BOOST_CHECK_THROW( index->region( 24 ), std::out_of_range );
+
+    const std::vector< double > tableValues = { 0.1, 0.2, 0.3 };
+    SupportedKeywordInfo keywordInfo( "SWL",
+                                      [&]( size_t ) {
+                                          Opm::GridPropertyLookup< double > lookup;
+                                          lookup.regions = regions.regionIndex();
+                                          lookup.values = tableValues;
+                                          return lookup;
+                                      },
+                                      "1" );
+    BOOST_CHECK( keywordInfo.hasLookup() );
+
+    std::vector< double > expected( 24 );
+    for (size_t g = 0; g < 24; g++)
+        expected[g] = tableValues[ regions.iget( g ) - 1 ];
+    BOOST_CHECK( keywordInfo.initializer()( 24 ) == expected );
+
+    Opm::GridProperty<double> prop( 4, 3, 2, keywordInfo );
+    BOOST_CHECK( prop.getStorage() == Storage::Lookup );
+    for (size_t g = 0; g < 24; g++)
+        BOOST_CHECK_EQUAL( prop.iget( g ), expected[g] );
+
+    size_t next = 0;
+    prop.forEachRange( [&]( size_t begin, size_t end, double value ) {
+            BOOST_CHECK_EQUAL( begin, next );
+            for (size_t g = begin; g < end; g++)
+                BOOST_CHECK_EQUAL( value, expected[g] );
+            next = end;
+        } );
+    BOOST_CHECK_EQUAL( next, 24U );
+
+    /* global operations and reads keep the lookup */
+    prop.scale( 2.0, global );
+    prop.iset( 1, prop.iget( 1 ));
+    BOOST_CHECK( prop.getStorage() == Storage::Lookup );
+    BOOST_CHECK_EQUAL( prop.iget( 5 ), 0.6 );
+
+    /* the region property can change without affecting the lookup */
+    regions.setScalar( 1, global );
+    BOOST_CHECK_EQUAL( prop.iget( 12 ), 0.4 );
+
+    prop.iset( 12, 1.0 );
+    BOOST_CHECK( prop.getStorage() == Storage::Dense );
+    BOOST_CHECK_EQUAL( prop.getData()[12], 1.0 );
+    BOOST_CHECK_EQUAL( prop.getData()[13], 0.4 );
+    BOOST_CHECK_EQUAL( prop.getData()[15], 0.6 );
+}
+
+
+BOOST_AUTO_TEST_CASE(ApplyEdits) {
+    typedef Opm::GridProperty<double>::SupportedKeywordInfo SupportedKeywordInfo;
+    typedef Opm::GridProperty<double>::Edit Edit;
+    typedef Opm::GridProperty<double>::Storage Storage;
+    SupportedKeywordInfo keywordInfo( "P1", 1.0, "1" );
+    Opm::GridProperty<double> fused( 5, 4, 3, keywordInfo );
+    Opm::GridProperty<double> serial( 5, 4, 3, keywordInfo );
+
+    for (size_t g = 0; g < 60; g++) {
+        fused.iset( g, 0.1 * g );
+        serial.iset( g, 0.1 * g );
+    }
+
+    Opm::Box global( 5, 4, 3 );
+    const std::vector< Edit > edits = {
+        { Edit::Kind::Scale, 3.0, Opm::Box( global, 0, 2, 0, 3, 0, 1 ) },
+        { Edit::Kind::Add,   0.7, Opm::Box( global, 1, 4, 1, 2, 1, 2 ) },
+        { Edit::Kind::Set,   5.0, Opm::Box( global, 4, 4, 0, 0, 0, 0 ) },
+        { Edit::Kind::Scale, 1.1, global },
+        { Edit::Kind::Add,  -0.3, Opm::Box( global, 0, 0, 3, 3, 2, 2 ) }
+    };
+
+    fused.apply( edits );
+    serial.scale( 3.0, edits[0].box );
+    serial.add( 0.7, edits[1].box );
+    serial.setScalar( 5.0, edits[2].box );
+    serial.scale( 1.1, edits[3].box );
+    serial.add( -0.3, edits[4].box );
+
+    BOOST_CHECK( fused.getStorage() == Storage::Dense );
+    for (size_t g = 0; g < 60; g++)
+        BOOST_CHECK_EQUAL( serial.iget( g ), fused.iget( g ));
+
+    /* disjoint per-layer boxes, as for EQUALS with one record per layer */
+    std::vector< Edit > layers;
+    for (size_t k = 0; k < 3; k++) {
+        layers.push_back( { Edit::Kind::Set, 10.0 + k, Opm::Box( global, 0, 4, 0, 3, k, k ) } );
+        layers.push_back( { Edit::Kind::Scale, 2.0, Opm::Box( global, 1, 2, 1, 1, k, k ) } );
+    }
+    layers.push_back( { Edit::Kind::Add, 0.5, Opm::Box( global, 3, 4, 3, 3, 1, 1 ) } );
+
+    fused.apply( layers );
+    for (const auto& edit : layers) {
+        if (edit.kind == Edit::Kind::Set)
+            serial.setScalar( edit.value, edit.box );
+        else if (edit.kind == Edit::Kind::Add)
+            serial.add( edit.value, edit.box );
+        else
+            serial.scale( edit.value, edit.box );
+    }
+
+    BOOST_CHECK( fused.getStorage() == Storage::Dense );
+    for (size_t g = 0; g < 60; g++)
+        BOOST_CHECK_EQUAL( serial.iget( g ), fused.iget( g ));
+    BOOST_CHECK_EQUAL( fused.iget( 1 , 1 , 2 ), 24.0 );
+    BOOST_CHECK_EQUAL( fused.iget( 4 , 3 , 1 ), 11.5 );
+
+    /* a global EQUALS goes back to Constant storage */
+    fused.apply( { { Edit::Kind::Add, 1.0, edits[0].box }, { Edit::Kind::Set, 2.0, global }, { Edit::Kind::Add, 1.0, global } } );
+    BOOST_CHECK( fused.getStorage() == Storage::Constant );
+    BOOST_CHECK_EQUAL( fused.iget( 7 ), 3.0 );
+}
@@ -264,3 +264,110 @@ BOOST_AUTO_TEST_CASE(MULTREGT_COPY_MULTNUM) {
         BOOST_CHECK_EQUAL(fdata[i], data[i]);
     }
 }
+
+
+static Opm::Deck createMULTREGTDeck() {
+    const char* deckData =
+        "RUNSPEC\n"
+        "\n"
+        "DIMENS\n"
+        "2 2 2 /\n"
+        "GRID\n"
+        "DX\n"
+        "8*0.25 /\n"
+        "DY\n"
+        "8*0.25 /\n"
+        "DZ\n"
+        "8*0.25 /\n"
+        "TOPS\n"
+        "4*0.25 /\n"
+        "FLUXNUM\n"
+        "1 2\n"
+        "1 2\n"
+        "3 4\n"
+        "3 4\n"
+        "/\n"
+        "MULTREGT\n"
+        "1  2   0.50   X     ALL    F /\n"
+        "1  3   0.25   Z     ALL    F /\n"
+        "4  2   2.00   XYZ   NONNC  F /\n"
+        "3  4   3.00   X     ALL    F /\n"
+        "/\n"
+        "EDIT\n"
+        "\n";
+
+    Opm::Parser parser;
+    return parser.parseString(deckData, Opm::ParseContext()) ;
+}
+
+
+BOOST_AUTO_TEST_CASE(MULTREGT_BULK) {
+    Opm::Deck deck = createMULTREGTDeck();
+    Opm::TableManager tm(deck);
+    Opm::EclipseGrid grid(deck);
+    Opm::Eclipse3DProperties props(deck, tm, grid);
+    Opm::MULTREGTScanner scanner( props, deck.getKeywordList( "MULTREGT" ));
+
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 0 , 1 , Opm::FaceDir::XPlus ) , 0.50 );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 1 , 0 , Opm::FaceDir::XPlus ) , 0.50 );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 0 , 1 , Opm::FaceDir::YPlus ) , 1.00 );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 5 , 4 , Opm::FaceDir::XPlus ) , 3.00 );
+    /* NONNC does not apply to the vertical neighbours */
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 1 , 5 , Opm::FaceDir::ZPlus ) , 1.00 );
+
+    const std::vector< double > multx = { 0.50, 1, 0.50, 1, 3.00, 1, 3.00, 1 };
+    const std::vector< double > multy = { 1, 1, 1, 1, 1, 1, 1, 1 };
+    const std::vector< double > multz = { 0.25, 1, 0.25, 1, 1, 1, 1, 1 };
+
+    const Opm::GridDims dims( 2 , 2 , 2 );
+    const auto x = scanner.getRegionMultipliers( dims , Opm::FaceDir::XPlus );
+    const auto y = scanner.getRegionMultipliers( dims , Opm::FaceDir::YPlus );
+    const auto z = scanner.getRegionMultipliers( dims , Opm::FaceDir::ZPlus );
+    BOOST_CHECK_EQUAL_COLLECTIONS( x.begin() , x.end() , multx.begin() , multx.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( y.begin() , y.end() , multy.begin() , multy.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( z.begin() , z.end() , multz.begin() , multz.end() );
+
+    BOOST_CHECK_THROW( scanner.getRegionMultipliers( dims , Opm::FaceDir::XMinus ) , std::invalid_argument );
+
+    /* The NNC multipliers ignore the directions, and the NONNC records */
+    BOOST_CHECK_EQUAL( scanner.getNNCMultiplier( 0 , 3 ) , 0.50 );
+    BOOST_CHECK_EQUAL( scanner.getNNCMultiplier( 4 , 2 ) , 0.25 );
+    BOOST_CHECK_EQUAL( scanner.getNNCMultiplier( 5 , 1 ) , 1.00 );
+    BOOST_CHECK_EQUAL( scanner.getNNCMultiplier( 4 , 7 ) , 3.00 );
+    BOOST_CHECK_EQUAL( scanner.getNNCMultiplier( 0 , 2 ) , 1.00 );
+}
+
+
+BOOST_AUTO_TEST_CASE(MULTREGT_LARGE_REGION_VALUES) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "\n"
+        "DIMENS\n"
+        "3 1 1 /\n"
+        "GRID\n"
+        "DX\n"
+        "3*0.25 /\n"
+        "DY\n"
+        "3*0.25 /\n"
+        "DZ\n"
+        "3*0.25 /\n"
+        "TOPS\n"
+        "3*0.25 /\n"
+        "FLUXNUM\n"
+        "7 2000000000 1000000 /\n"
+        "MULTREGT\n"
+        "7  2000000000   0.50   X   ALL    F /\n"
+        "/\n"
+        "EDIT\n"
+        "\n";
+
+    Opm::Parser parser;
+    Opm::Deck deck = parser.parseString(deckData, Opm::ParseContext());
+    Opm::TableManager tm(deck);
+    Opm::EclipseGrid grid(deck);
+    Opm::Eclipse3DProperties props(deck, tm, grid);
+    Opm::MULTREGTScanner scanner( props, deck.getKeywordList( "MULTREGT" ));
+
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 0 , 1 , Opm::FaceDir::XPlus ) , 0.50 );
+    BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( 1 , 2 , Opm::FaceDir::XPlus ) , 1.00 );
+}
@@ -79,3 +79,71 @@ BOOST_AUTO_TEST_CASE(appendMessages) {
     BOOST_CHECK_EQUAL("Error: msgContainer.", msgContainer.begin()->message);
     BOOST_CHECK_EQUAL("Warning: msgList.", (msgContainer.end()-1)->message);
 }
+
+
+BOOST_AUTO_TEST_CASE(DuplicateMessages) {
+    MessageContainer mc;
+    mc.warning( "Warning" );
+    mc.warning( "Warning" );
+    mc.warning( "Warning", "filename", 10 );
+    mc.error( "Warning" );
+
+    BOOST_CHECK_EQUAL( 3U, mc.size() );
+    BOOST_CHECK_EQUAL( 2U, mc.begin()->count );
+    BOOST_CHECK_EQUAL( 1U, (mc.begin() + 1)->count );
+    BOOST_CHECK_EQUAL( 4U, mc.count( "" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE(CategoryLimit) {
+    MessageContainer mc;
+    BOOST_CHECK_EQUAL( MessageContainer::defaultCategoryLimit, mc.getCategoryLimit() );
+
+    mc.setCategoryLimit( 2 );
+    size_t formatted = 0;
+    for( int i = 0; i < 10; i++ )
+        mc.add( "CATEGORY", Message::Warning, [&formatted, i]() {
+                formatted++;
+                return "Message " + std::to_string( i );
+            }, "FILE", i + 1 );
+
+    BOOST_CHECK_EQUAL( 2U, formatted );
+
+    /* a repeat of a stored message is counted, also when the category is full */
+    mc.add( "CATEGORY", Message::Warning, [&formatted]() {
+            formatted++;
+            return std::string( "Message 0" );
+        }, "FILE", 1 );
+
+    Message repeat { Message::Warning, "Message 1", Location { "FILE", 2 } };
+    repeat.category = "CATEGORY";
+    mc.add( std::move( repeat ) );
+    mc.warning( "Uncategorized" );
+
+    BOOST_CHECK_EQUAL( 3U, formatted );
+    BOOST_CHECK_EQUAL( 3U, mc.size() );
+    BOOST_CHECK_EQUAL( "CATEGORY", mc.begin()->category );
+    BOOST_CHECK_EQUAL( 2U, mc.begin()->count );
+    BOOST_CHECK_EQUAL( 2U, (mc.begin() + 1)->count );
+    BOOST_CHECK_EQUAL( 12U, mc.count( "CATEGORY" ) );
+    BOOST_CHECK_EQUAL( 8U, mc.dropped( "CATEGORY" ) );
+    BOOST_CHECK_EQUAL( 0U, mc.count( "OTHER" ) );
+
+    MessageContainer lazy;
+    lazy.setCategoryLimit( 1 );
+    lazy.add( "CATEGORY", Message::Note, []() { return std::string( "A" ); } );
+    lazy.add( "CATEGORY", Message::Note, []() { return std::string( "A" ); } );
+    lazy.add( "CATEGORY", Message::Note, []() { return std::string( "B" ); } );
+    BOOST_CHECK_EQUAL( 1U, lazy.size() );
+    BOOST_CHECK_EQUAL( 2U, lazy.begin()->count );
+    BOOST_CHECK_EQUAL( 3U, lazy.count( "CATEGORY" ) );
+    BOOST_CHECK_EQUAL( 1U, lazy.dropped( "CATEGORY" ) );
+
+    MessageContainer other;
+    other.warning( "Uncategorized" );
+    other.appendMessages( std::move( mc ) );
+    BOOST_CHECK_EQUAL( 3U, other.size() );
+    BOOST_CHECK_EQUAL( 2U, other.begin()->count );
+    BOOST_CHECK_EQUAL( 12U, other.count( "CATEGORY" ) );
+    BOOST_CHECK_EQUAL( 8U, other.dropped( "CATEGORY" ) );
+}
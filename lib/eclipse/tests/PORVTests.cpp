@@ -386,6 +386,72 @@ BOOST_AUTO_TEST_CASE(PORV_multregp) {
 }
 
 
+BOOST_AUTO_TEST_CASE(PORV_multregpIllegalRegionType) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "\n"
+        "DIMENS\n"
+        " 10 10 10 /\n"
+        "GRID\n"
+        "DX\n"
+        "1000*0.25 /\n"
+        "DYV\n"
+        "10*0.25 /\n"
+        "DZ\n"
+        "1000*0.25 /\n"
+        "TOPS\n"
+        "100*0.25 /\n"
+        "PORV\n"
+        "1000*77 /\n"
+        "MULTREGP\n"
+        "1 2.0 F/ \n"
+        "2 20.0 X / \n"
+        "/\n"
+        "\n";
+
+    Opm::Deck deck = Opm::Parser().parseString(deckData, Opm::ParseContext());
+    Opm::TableManager tm( deck );
+    Opm::EclipseGrid grid( deck );
+    Opm::Eclipse3DProperties props( deck, tm, grid );
+    BOOST_CHECK_THROW( props.getDoubleGridProperty("PORV"), std::logic_error );
+}
+
+
+BOOST_AUTO_TEST_CASE(PORV_multregpLargeRegionId) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "\n"
+        "DIMENS\n"
+        " 10 10 10 /\n"
+        "GRID\n"
+        "DX\n"
+        "1000*0.25 /\n"
+        "DYV\n"
+        "10*0.25 /\n"
+        "DZ\n"
+        "1000*0.25 /\n"
+        "TOPS\n"
+        "100*0.25 /\n"
+        "PORV\n"
+        "1000*77 /\n"
+        "MULTNUM\n"
+        "500*1 500*2000000000 / \n"
+        "MULTREGP\n"
+        "2000000000 2.0 M / \n"
+        "/\n"
+        "\n";
+
+    Opm::Deck deck = Opm::Parser().parseString(deckData, Opm::ParseContext());
+    Opm::TableManager tm( deck );
+    Opm::EclipseGrid grid( deck );
+    Opm::Eclipse3DProperties props( deck, tm, grid );
+    const auto& porv = props.getDoubleGridProperty("PORV");
+
+    BOOST_CHECK_CLOSE( 77.0    , porv.iget(0) , 1e-8 );
+    BOOST_CHECK_CLOSE( 77.0 * 2, porv.iget(999) , 1e-8 );
+}
+
+
 static Opm::Deck createDeckNakedGRID() {
     const char* deckData =
         "RUNSPEC\n"
@@ -0,0 +1,175 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE ParallelTests
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Utility/Parallel.hpp>
+
+
+using namespace Opm;
+
+/*
+  The number of threads is read once, so force several threads before the
+  first parallel loop runs to exercise the multi-threaded code path also on
+  single core machines.
+*/
+struct ForceThreads {
+    ForceThreads() { setenv( "OPM_NUM_THREADS", "4", 1 ); }
+};
+
+BOOST_GLOBAL_FIXTURE( ForceThreads );
+
+
+BOOST_AUTO_TEST_CASE(NumThreads) {
+    BOOST_CHECK_EQUAL( 4U, parallel::num_threads() );
+}
+
+
+BOOST_AUTO_TEST_CASE(ForEachVisitsAll) {
+    std::vector< int > visited( 10000, 0 );
+    parallel::for_each( visited.size(), [&]( size_t index ) {
+        visited[ index ] += 1;
+    }, 10 );
+
+    for( const auto& v : visited )
+        BOOST_CHECK_EQUAL( 1, v );
+}
+
+
+BOOST_AUTO_TEST_CASE(ForRangesDisjoint) {
+    std::vector< size_t > chunk( 1000, 0 );
+    parallel::for_ranges( chunk.size(), [&]( size_t begin, size_t end ) {
+        for( size_t index = begin; index < end; ++index )
+            chunk[ index ] = begin + 1;
+    }, 100 );
+
+    for( size_t index = 1; index < chunk.size(); ++index )
+        BOOST_CHECK( chunk[ index ] == chunk[ index - 1 ] || chunk[ index ] == index + 1 );
+
+    size_t calls = 0;
+    parallel::for_ranges( 0, [&]( size_t, size_t ) { calls++; } );
+    BOOST_CHECK_EQUAL( 0U, calls );
+}
+
+
+BOOST_AUTO_TEST_CASE(ExceptionIsRethrown) {
+    BOOST_CHECK_THROW( parallel::for_each( 1000, []( size_t index ) {
+        if( index == 999 ) throw std::invalid_argument( "Index 999" );
+    }, 10 ), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(GatherScatter) {
+    const size_t size = 200000;
+    std::vector< double > src( size );
+    std::vector< int > index;
+
+    for( size_t i = 0; i < size; ++i ) {
+        src[ i ] = 0.5 * i;
+        if( i % 3 != 1 ) index.push_back( int( i ) );
+    }
+
+    std::vector< double > gathered( index.size() );
+    parallel::gather( index.size(), index.data(), src.data(), gathered.data(), 1024 );
+    for( size_t i = 0; i < index.size(); ++i )
+        BOOST_CHECK_EQUAL( gathered[ i ], src[ index[ i ] ] );
+
+    std::vector< double > scattered( size, -1 );
+    parallel::scatter( index.size(), index.data(), gathered.data(), scattered.data(), 1024 );
+    for( size_t i = 0; i < size; ++i )
+        BOOST_CHECK_EQUAL( scattered[ i ], i % 3 != 1 ? src[ i ] : -1 );
+}
+
+
+BOOST_AUTO_TEST_CASE(TaskGraphOrder) {
+    std::vector< int > a, b;
+    parallel::task_graph tasks;
+
+    for( int i = 0; i < 100; ++i ) {
+        tasks.add( [&a, i] { a.push_back( i ); }, { "A" } );
+        tasks.add( [&b, i] { b.push_back( i ); }, { "B" } );
+    }
+    tasks.add( [&] { a.insert( a.end(), b.begin(), b.end() ); }, { "A", "B" } );
+    tasks.add( [&] { b.clear(); }, { "B" } );
+
+    BOOST_CHECK_EQUAL( 202U, tasks.size() );
+    tasks.run();
+    BOOST_CHECK( tasks.empty() );
+
+    BOOST_CHECK_EQUAL( 200U, a.size() );
+    for( size_t i = 0; i < a.size(); ++i )
+        BOOST_CHECK_EQUAL( int( i % 100 ), a[ i ] );
+
+    BOOST_CHECK( b.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE(TaskGraphException) {
+    int done = 0;
+    parallel::task_graph tasks;
+
+    tasks.add( [&] { done = 1; }, { "A" } );
+    tasks.add( [] { throw std::invalid_argument( "First" ); }, { "B" } );
+    tasks.add( [] { throw std::logic_error( "Second" ); }, { "C" } );
+
+    BOOST_CHECK_THROW( tasks.run(), std::invalid_argument );
+    BOOST_CHECK_EQUAL( 1, done );
+    BOOST_CHECK( tasks.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE(NestedLoopsAreSerial) {
+    BOOST_CHECK( !parallel::in_worker() );
+
+    /* the number of chunks every nested loop was split in */
+    std::vector< size_t > chunks( 4, 0 );
+    parallel::task_graph tasks;
+    for( size_t t = 0; t < chunks.size(); ++t )
+        tasks.add( [&chunks, t] {
+                parallel::for_ranges( 10000, [&chunks, t]( size_t, size_t ) {
+                    chunks[ t ]++;
+                }, 10 );
+            }, { std::to_string( t ) } );
+    tasks.run();
+
+    for( const auto& c : chunks )
+        BOOST_CHECK_EQUAL( 1U, c );
+
+    std::vector< size_t > nested( 4, 0 );
+    std::vector< int > worker( 4, 0 );
+    parallel::for_each( nested.size(), [&nested, &worker]( size_t index ) {
+        worker[ index ] = parallel::in_worker();
+        parallel::for_ranges( 10000, [&nested, index]( size_t, size_t ) {
+            nested[ index ]++;
+        }, 10 );
+    }, 1 );
+
+    for( size_t index = 0; index < nested.size(); ++index ) {
+        BOOST_CHECK_EQUAL( 1U, nested[ index ] );
+        BOOST_CHECK_EQUAL( 1, worker[ index ] );
+    }
+
+    BOOST_CHECK( !parallel::in_worker() );
+}
@@ -417,3 +417,58 @@ BOOST_AUTO_TEST_CASE(test_1arg_constructor) {
         BOOST_CHECK_EQUAL(ctx.get(ParseContext::PARSE_RANDOM_SLASH), InputError::IGNORE);
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(test_lazy_handleError) {
+    ParseContext ctx;
+    MessageContainer msgContainer;
+    size_t formatted = 0;
+    const auto msg = [&formatted]() {
+        formatted++;
+        return std::string( "Random text" );
+    };
+
+    ctx.update( ParseContext::PARSE_RANDOM_TEXT, InputError::IGNORE );
+    BOOST_CHECK_EQUAL( Message::Debug, ctx.handleError( ParseContext::PARSE_RANDOM_TEXT, msgContainer, msg ) );
+    BOOST_CHECK_EQUAL( 0U, formatted );
+    BOOST_CHECK_EQUAL( 0U, msgContainer.size() );
+
+    ctx.update( ParseContext::PARSE_RANDOM_TEXT, InputError::WARN );
+    ctx.handleError( ParseContext::PARSE_RANDOM_TEXT, msgContainer, msg );
+    ctx.handleError( ParseContext::PARSE_RANDOM_TEXT, msgContainer, msg );
+    BOOST_CHECK_EQUAL( 2U, formatted );
+    BOOST_CHECK_EQUAL( 1U, msgContainer.size() );
+    BOOST_CHECK_EQUAL( ParseContext::PARSE_RANDOM_TEXT, msgContainer.begin()->category );
+    BOOST_CHECK_EQUAL( 2U, msgContainer.count( ParseContext::PARSE_RANDOM_TEXT ) );
+
+    ctx.update( ParseContext::PARSE_RANDOM_TEXT, InputError::THROW_EXCEPTION );
+    BOOST_CHECK_THROW( ctx.handleError( ParseContext::PARSE_RANDOM_TEXT, msgContainer, msg ), std::invalid_argument );
+    BOOST_CHECK_EQUAL( 3U, formatted );
+}
+
+
+BOOST_AUTO_TEST_CASE(test_error_key_ids) {
+    ParseContext ctx;
+
+    BOOST_CHECK_EQUAL( ParseContext::PARSE_EXTRA_DATA, ParseContext::keyName( ParseContext::ErrorKey::PARSE_EXTRA_DATA ) );
+    BOOST_CHECK_EQUAL( ParseContext::SUMMARY_UNKNOWN_GROUP, ParseContext::keyName( ParseContext::ErrorKey::SUMMARY_UNKNOWN_GROUP ) );
+
+    ctx.update( ParseContext::PARSE_EXTRA_DATA, InputError::IGNORE );
+    ctx.update( "UNSUPPORTED_*", InputError::WARN );
+    BOOST_CHECK_EQUAL( InputError::IGNORE, ctx.get( ParseContext::ErrorKey::PARSE_EXTRA_DATA ) );
+    BOOST_CHECK_EQUAL( InputError::WARN, ctx.get( ParseContext::ErrorKey::UNSUPPORTED_COMPORD_TYPE ) );
+
+    for( int id = 0; id < static_cast< int >( ParseContext::ErrorKey::NUM_KEYS ); id++ ) {
+        const auto key = static_cast< ParseContext::ErrorKey >( id );
+        BOOST_CHECK( ctx.hasKey( ParseContext::keyName( key ) ) );
+        BOOST_CHECK_EQUAL( ctx.get( ParseContext::keyName( key ) ), ctx.get( key ) );
+    }
+
+    ParseContext copy = ctx.withKey( ParseContext::PARSE_RANDOM_TEXT, InputError::WARN );
+    BOOST_CHECK_EQUAL( InputError::WARN, copy.get( ParseContext::ErrorKey::PARSE_RANDOM_TEXT ) );
+
+    MessageContainer msgContainer;
+    BOOST_CHECK_EQUAL( Message::Debug, ctx.handleError( ParseContext::ErrorKey::PARSE_EXTRA_DATA, msgContainer, "Extra data" ) );
+    BOOST_CHECK_EQUAL( Message::Warning, ctx.handleError( ParseContext::ErrorKey::UNSUPPORTED_COMPORD_TYPE, msgContainer, "COMPORD" ) );
+    BOOST_CHECK_EQUAL( ParseContext::UNSUPPORTED_COMPORD_TYPE, msgContainer.begin()->category );
+}
@@ -18,6 +18,8 @@
  */
 
 #define BOOST_TEST_MODULE ParserTests
+#include <sstream>
+
 #include <boost/test/unit_test.hpp>
 
 #include <opm/json/JsonObject.hpp>
@@ -29,6 +31,7 @@
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+#include <opm/parser/eclipse/Parser/ParserStatistics.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 
@@ -1850,6 +1853,27 @@ PVT-M
     BOOST_CHECK( deck.hasKeyword( "PVT-M" ) );
 }
 
+BOOST_AUTO_TEST_CASE(ApplyUnitsManyKeywords)
+{
+    std::string deck_string = "FIELD\n";
+    for( int i = 0; i < 200; i++ )
+        deck_string += "DX\n 3*1.0 /\n";
+
+    Parser parser;
+    const auto deck = parser.parseString( deck_string, ParseContext() );
+
+    BOOST_CHECK_EQUAL( 200U, deck.count( "DX" ) );
+    for( const auto* kw : deck.getKeywordList( "DX" ) ) {
+        /* the parser does not leave pointers to its keywords in the deck */
+        BOOST_CHECK( !kw->getParserKeyword() );
+
+        const auto& si = kw->getSIDoubleData();
+        BOOST_CHECK_EQUAL( 3U, si.size() );
+        for( const auto& x : si )
+            BOOST_CHECK_CLOSE( 0.3048, x, 1e-8 );
+    }
+}
+
 
 
 BOOST_AUTO_TEST_CASE(ParseAQUTAB) {
@@ -1873,3 +1897,66 @@ AQUTAB
   BOOST_CHECK_EQUAL( 1, aqutab.size());
 }
 
+
+
+BOOST_AUTO_TEST_CASE(ParserStatisticsOptIn) {
+    const auto * deck_string = R"(
+RUNSPEC
+
+DIMENS
+ 2 2 1 /
+
+GRID
+
+DX
+ 4*0.25 /
+
+PORO
+ 4*0.10 /
+
+PORO
+ 4*0.20 /
+)";
+
+    Parser parser;
+    const auto plain_deck = parser.parseString( deck_string, ParseContext() );
+    BOOST_CHECK( !plain_deck.getParserStatistics() );
+
+    parser.enableStatistics();
+    const auto deck = parser.parseString( deck_string, ParseContext() );
+    const auto stats = deck.getParserStatistics();
+    BOOST_CHECK( stats );
+    BOOST_CHECK( stats != parser.parseString( deck_string, ParseContext() ).getParserStatistics() );
+
+    const auto& keywords = stats->keywords();
+    BOOST_CHECK_EQUAL( 5U, keywords.size() );
+    BOOST_CHECK_EQUAL( 2U, keywords.at( "PORO" ).count );
+    BOOST_CHECK_EQUAL( 8U, keywords.at( "PORO" ).values );
+    BOOST_CHECK_EQUAL( 3U, keywords.at( "DIMENS" ).values );
+    BOOST_CHECK( keywords.at( "DX" ).bytes > 0 );
+
+    using phase = ParserStatistics::phase;
+    BOOST_CHECK_EQUAL( 6U, stats->get( phase::keyword_parse ).count );
+    BOOST_CHECK_EQUAL( 1U, stats->get( phase::units ).count );
+    BOOST_CHECK_EQUAL( 0U, stats->get( phase::file_io ).count );
+    BOOST_CHECK( stats->total() >= stats->get( phase::keyword_parse ).seconds );
+
+    std::stringstream table, json;
+    stats->writeTable( table );
+    stats->writeJSON( json );
+    BOOST_CHECK( table.str().find( "PORO" ) != std::string::npos );
+    BOOST_CHECK( json.str().find( "\"PORO\": { \"count\": 2" ) != std::string::npos );
+}
+
+
+BOOST_AUTO_TEST_CASE(ParserStatisticsIncludeTree) {
+    ParserStatistics stats;
+    const auto root = stats.addFile( "CASE.DATA", ParserStatistics::root );
+    const auto grid = stats.addFile( "grid.inc", root );
+    const auto faults = stats.addFile( "faults.inc", grid );
+
+    BOOST_CHECK_EQUAL( 0U, stats.files().at( root ).depth );
+    BOOST_CHECK_EQUAL( grid, stats.files().at( faults ).parent );
+    BOOST_CHECK_EQUAL( 2U, stats.files().at( faults ).depth );
+    BOOST_CHECK_THROW( stats.addFile( "bad.inc", 17 ), std::invalid_argument );
+}
@@ -123,6 +123,10 @@ BOOST_AUTO_TEST_CASE(SaturationFunctionFamilyTests) {
     Opm::EclipseGrid grid2( deck2 );
     Opm::Eclipse3DProperties prop2( deck2, tm2, grid2 );
 
+    /* the endpoints are looked up by SATNUM until they are modified */
+    BOOST_CHECK( prop1.getDoubleGridProperty("SWL").getStorage() == GridProperty<double>::Storage::Lookup );
+    BOOST_CHECK( prop2.getDoubleGridProperty("KRO").getStorage() == GridProperty<double>::Storage::Lookup );
+
     check_property(prop1, prop2, "SWL");
     check_property(prop1, prop2, "SWU");
     check_property(prop1, prop2, "SWCR");
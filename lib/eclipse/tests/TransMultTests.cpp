@@ -30,6 +30,10 @@
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 
 BOOST_AUTO_TEST_CASE(Empty) {
     Opm::Eclipse3DProperties props;
@@ -44,3 +48,83 @@ BOOST_AUTO_TEST_CASE(Empty) {
     BOOST_CHECK_EQUAL( transMult.getMultiplier(9,9,9, Opm::FaceDir::YMinus) , 1.0 );
     BOOST_CHECK_EQUAL( transMult.getMultiplier(100 , Opm::FaceDir::ZMinus) , 1.0 );
 }
+
+
+BOOST_AUTO_TEST_CASE(BulkMultipliers) {
+    Opm::Eclipse3DProperties props;
+    Opm::TransMult transMult(Opm::GridDims(2,2,2) ,{} , props);
+    Opm::GridPropertySupportedKeywordInfo<double> kwInfo("MULTX" , 1.0 , "1");
+    Opm::GridProperty<double> multx( 2 , 2 , 2 , kwInfo );
+    for (size_t g = 0; g < 8; g++)
+        multx.iset( g , 1.0 + g );
+
+    BOOST_CHECK( transMult.isUniform( Opm::FaceDir::XPlus ));
+    BOOST_CHECK( transMult.getMultipliers( Opm::FaceDir::XPlus ).empty() );
+
+    transMult.applyMULT( multx , Opm::FaceDir::XPlus );
+    transMult.applyMULT( multx , Opm::FaceDir::XPlus );
+    BOOST_CHECK( !transMult.isUniform( Opm::FaceDir::XPlus ));
+    BOOST_CHECK( transMult.isUniform( Opm::FaceDir::XMinus ));
+
+    const auto& mult = transMult.getMultipliers( Opm::FaceDir::XPlus );
+    BOOST_CHECK_EQUAL( mult.size() , 8U );
+    for (size_t g = 0; g < 8; g++) {
+        BOOST_CHECK_EQUAL( mult[g] , (1.0 + g) * (1.0 + g) );
+        BOOST_CHECK_EQUAL( transMult.getMultiplier( g , Opm::FaceDir::XPlus ) , mult[g] );
+    }
+
+    Opm::EclipseGrid grid( 2 , 2 , 2 );
+    std::vector<int> actnum = { 1 , 0 , 1 , 1 , 0 , 1 , 1 , 1 };
+    grid.resetACTNUM( actnum.data() );
+
+    const auto active = transMult.getActiveMultipliers( grid , Opm::FaceDir::XPlus );
+    const std::vector<double> expected = { 1 , 9 , 16 , 36 , 49 , 64 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( active.begin() , active.end() , expected.begin() , expected.end() );
+
+    const auto uniform = transMult.getActiveMultipliers( grid , Opm::FaceDir::YMinus );
+    BOOST_CHECK_EQUAL( uniform.size() , 6U );
+    for (auto m : uniform)
+        BOOST_CHECK_EQUAL( m , 1.0 );
+}
+
+
+BOOST_AUTO_TEST_CASE(BulkMULTFLT) {
+    Opm::Eclipse3DProperties props;
+    Opm::TransMult transMult(Opm::GridDims(4,3,5) ,{} , props);
+    Opm::FaultCollection faults;
+
+    faults.addFault( "F1" );
+    faults.addFault( "F2" );
+    faults.getFault( "F1" ).addFace( Opm::FaultFace( 4 , 3 , 5 , 1 , 1 , 0 , 2 , 0 , 4 , Opm::FaceDir::XPlus ));
+    faults.getFault( "F1" ).addFace( Opm::FaultFace( 4 , 3 , 5 , 0 , 3 , 1 , 1 , 2 , 2 , Opm::FaceDir::YMinus ));
+    faults.getFault( "F2" ).addFace( Opm::FaultFace( 4 , 3 , 5 , 1 , 1 , 1 , 1 , 1 , 3 , Opm::FaceDir::XPlus ));
+    faults.setTransMult( "F1" , 0.5 );
+    faults.setTransMult( "F2" , 0.1 );
+
+    transMult.applyMULTFLT( faults );
+    BOOST_CHECK( transMult.isUniform( Opm::FaceDir::XMinus ));
+    BOOST_CHECK( transMult.isUniform( Opm::FaceDir::ZPlus ));
+
+    for (size_t k = 0; k < 5; k++) {
+        for (size_t j = 0; j < 3; j++) {
+            for (size_t i = 0; i < 4; i++) {
+                double x = 1.0;
+                double y = 1.0;
+                if (i == 1)
+                    x *= 0.5;
+                if (i == 1 && j == 1 && k >= 1 && k <= 3)
+                    x *= 0.1;
+                if (j == 1 && k == 2)
+                    y *= 0.5;
+
+                BOOST_CHECK_CLOSE( transMult.getMultiplier( i , j , k , Opm::FaceDir::XPlus ) , x , 1e-12 );
+                BOOST_CHECK_CLOSE( transMult.getMultiplier( i , j , k , Opm::FaceDir::YMinus ) , y , 1e-12 );
+            }
+        }
+    }
+
+    /* Schedule style MULTFLT: the factors are applied on top of the current multipliers */
+    transMult.applyMULTFLT( { std::make_pair( &faults.getFault( "F2" ) , 10.0 ) } );
+    BOOST_CHECK_CLOSE( transMult.getMultiplier( 1 , 1 , 2 , Opm::FaceDir::XPlus ) , 0.5 , 1e-12 );
+    BOOST_CHECK_CLOSE( transMult.getMultiplier( 1 , 1 , 0 , Opm::FaceDir::XPlus ) , 0.5 , 1e-12 );
+}
@@ -25,6 +25,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
 #include <memory>
 #include <ostream>
 
@@ -247,6 +248,33 @@ BOOST_AUTO_TEST_CASE( VectorConvert ) {
         BOOST_CHECK_EQUAL( units.from_si( UnitSystem::measure::pressure , d1[i] ) , d0[i]);
 }
 
+BOOST_AUTO_TEST_CASE( BulkDimensionConvert ) {
+    Dimension temp("Temperature" , 1 , 273.15);
+    std::vector<double> raw = {1,2,3,4,5,6,7};
+    std::vector<double> si( raw.size() , -1 );
+
+    temp.convertRawToSi( raw.data() , si.data() , raw.size() );
+    for (size_t i = 0; i < raw.size(); i++)
+        BOOST_CHECK_EQUAL( temp.convertRawToSi( raw[i] ) , si[i] );
+
+    std::vector<double> strided( raw.size() , -1 );
+    temp.convertRawToSi( raw.data() + 1 , strided.data() + 1 , raw.size() - 1 , 3 );
+    for (size_t i = 0; i < raw.size(); i++) {
+        if (i % 3 == 1)
+            BOOST_CHECK_EQUAL( temp.convertRawToSi( raw[i] ) , strided[i] );
+        else
+            BOOST_CHECK_EQUAL( -1 , strided[i] );
+    }
+
+    std::vector<double> back( raw.size() );
+    temp.convertSiToRaw( si.data() , back.data() , si.size() );
+    for (size_t i = 0; i < raw.size(); i++)
+        BOOST_CHECK_CLOSE( raw[i] , back[i] , 1e-10 );
+
+    Dimension contextDependent("Context" , std::numeric_limits<double>::quiet_NaN());
+    BOOST_CHECK_THROW( contextDependent.convertRawToSi( raw.data() , si.data() , raw.size() ) , std::logic_error );
+}
+
 BOOST_AUTO_TEST_CASE( GasOilRatioNotIdentityForField ) {
     const double gas = 14233.4;
     const double oil = 4223;